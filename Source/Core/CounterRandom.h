@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+
+//==============================================================================
+// Counter-based random numbers for the sequencer's per-trigger decisions.
+//
+// Instead of a stream that advances with every draw, each value is a pure
+// function of (seed, rotation, dot, stream) - Widynski's "Squares" generator
+// applied to a hash of the coordinates. So a dot's probability roll on a given
+// rotation is the same no matter how many dots were evaluated before it, where
+// the transport was relocated from, or which thread/chunk of an offline render
+// computes it, and any rotation can be evaluated in O(1).
+class CounterRandom
+{
+public:
+    // What a value is used for, so one dot's decisions are independent of each other
+    enum Stream : std::uint32_t
+    {
+        probabilityStream = 0,
+        velocityStream = 1
+    };
+
+    explicit CounterRandom(std::int64_t seed = 1) noexcept { setSeed(seed); }
+
+    void setSeed(std::int64_t seed) noexcept
+    {
+        // Squares needs a key with well-mixed bits; any odd mix of the seed works
+        key = mix(static_cast<std::uint64_t>(seed)) | 1;
+    }
+
+    std::uint32_t getUint32(std::int64_t rotation, std::uint32_t dotId, std::uint32_t stream) const noexcept
+    {
+        const std::uint64_t counter = mix(static_cast<std::uint64_t>(rotation)
+                                          ^ mix((static_cast<std::uint64_t>(dotId) << 8) | stream));
+        return squares32(counter, key);
+    }
+
+    // Uniform in [0, 1)
+    float getFloat(std::int64_t rotation, std::uint32_t dotId, std::uint32_t stream) const noexcept
+    {
+        return static_cast<float>(getUint32(rotation, dotId, stream) >> 8) * (1.0f / 16777216.0f);
+    }
+
+private:
+    std::uint64_t key = 1;
+
+    // SplitMix64 finaliser
+    static std::uint64_t mix(std::uint64_t x) noexcept
+    {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    static std::uint32_t squares32(std::uint64_t counter, std::uint64_t k) noexcept
+    {
+        std::uint64_t x = counter * k;
+        const std::uint64_t y = x;
+        const std::uint64_t z = y + k;
+
+        x = x * x + y;  x = (x >> 32) | (x << 32);
+        x = x * x + z;  x = (x >> 32) | (x << 32);
+        x = x * x + y;  x = (x >> 32) | (x << 32);
+        return static_cast<std::uint32_t>((x * x + z) >> 32);
+    }
+};
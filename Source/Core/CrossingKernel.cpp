@@ -0,0 +1,115 @@
+#include "CrossingKernel.h"
+
+#include <cmath>
+
+#if defined(__AVX2__)
+ #include <immintrin.h>
+ #define SKALD_CROSSING_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define SKALD_CROSSING_SSE2 1
+#endif
+
+namespace
+{
+    // The scalar definition every vector path has to match bit for bit
+    inline void computeCrossing(double degrees, double turn, double rotation, double degreesPerBeat,
+                                double anchorPpq, double ppqPerSample, double& sample, double& crossingTurn) noexcept
+    {
+        const double crossingDegrees = degrees + 360.0 * (rotation - turn);
+        sample = std::ceil((crossingDegrees / degreesPerBeat - anchorPpq) / ppqPerSample - 1.0e-6);
+        crossingTurn = std::floor(crossingDegrees / 360.0);
+    }
+
+   #if SKALD_CROSSING_SSE2
+    // SSE2 has no rounding instruction: round |x| to an integer by pushing it through
+    // 2^52 (exact below that; anything larger is already a whole number), put the sign
+    // back, and the callers correct by one wherever that rounded the wrong way
+    inline __m128d roundToInteger(__m128d x) noexcept
+    {
+        const __m128d signBit = _mm_set1_pd(-0.0);
+        const __m128d twoTo52 = _mm_set1_pd(4503599627370496.0);
+
+        const __m128d magnitude = _mm_andnot_pd(signBit, x);
+        __m128d rounded = _mm_sub_pd(_mm_add_pd(magnitude, twoTo52), twoTo52);
+        rounded = _mm_or_pd(rounded, _mm_and_pd(x, signBit));
+
+        const __m128d isFractional = _mm_cmplt_pd(magnitude, twoTo52);
+        return _mm_or_pd(_mm_and_pd(isFractional, rounded), _mm_andnot_pd(isFractional, x));
+    }
+
+    inline __m128d ceil2(__m128d x) noexcept
+    {
+        const __m128d rounded = roundToInteger(x);
+        return _mm_add_pd(rounded, _mm_and_pd(_mm_cmplt_pd(rounded, x), _mm_set1_pd(1.0)));
+    }
+
+    inline __m128d floor2(__m128d x) noexcept
+    {
+        const __m128d rounded = roundToInteger(x);
+        return _mm_sub_pd(rounded, _mm_and_pd(_mm_cmpgt_pd(rounded, x), _mm_set1_pd(1.0)));
+    }
+   #endif
+}
+
+//==============================================================================
+void CrossingKernel::computeSyncCrossings(const double* degrees, const double* turns, size_t numDots,
+                                          double rotation, double degreesPerBeat, double anchorPpq,
+                                          double ppqPerSample, double* crossingSamples, double* crossingTurns) noexcept
+{
+    size_t n = 0;
+
+   #if SKALD_CROSSING_AVX2
+    const __m256d rotationVector = _mm256_set1_pd(rotation);
+    const __m256d fullTurn = _mm256_set1_pd(360.0);
+    const __m256d degreesPerBeatVector = _mm256_set1_pd(degreesPerBeat);
+    const __m256d anchorVector = _mm256_set1_pd(anchorPpq);
+    const __m256d ppqPerSampleVector = _mm256_set1_pd(ppqPerSample);
+    const __m256d tolerance = _mm256_set1_pd(1.0e-6);
+
+    for (; n + 4 <= numDots; n += 4)
+    {
+        const __m256d turn = _mm256_sub_pd(rotationVector, _mm256_loadu_pd(turns + n));
+        const __m256d crossingDegrees = _mm256_add_pd(_mm256_loadu_pd(degrees + n), _mm256_mul_pd(fullTurn, turn));
+        const __m256d ppq = _mm256_div_pd(crossingDegrees, degreesPerBeatVector);
+        const __m256d samples = _mm256_sub_pd(_mm256_div_pd(_mm256_sub_pd(ppq, anchorVector), ppqPerSampleVector), tolerance);
+
+        _mm256_storeu_pd(crossingSamples + n, _mm256_ceil_pd(samples));
+        _mm256_storeu_pd(crossingTurns + n, _mm256_floor_pd(_mm256_div_pd(crossingDegrees, fullTurn)));
+    }
+   #elif SKALD_CROSSING_SSE2
+    const __m128d rotationVector = _mm_set1_pd(rotation);
+    const __m128d fullTurn = _mm_set1_pd(360.0);
+    const __m128d degreesPerBeatVector = _mm_set1_pd(degreesPerBeat);
+    const __m128d anchorVector = _mm_set1_pd(anchorPpq);
+    const __m128d ppqPerSampleVector = _mm_set1_pd(ppqPerSample);
+    const __m128d tolerance = _mm_set1_pd(1.0e-6);
+
+    for (; n + 2 <= numDots; n += 2)
+    {
+        const __m128d turn = _mm_sub_pd(rotationVector, _mm_loadu_pd(turns + n));
+        const __m128d crossingDegrees = _mm_add_pd(_mm_loadu_pd(degrees + n), _mm_mul_pd(fullTurn, turn));
+        const __m128d ppq = _mm_div_pd(crossingDegrees, degreesPerBeatVector);
+        const __m128d samples = _mm_sub_pd(_mm_div_pd(_mm_sub_pd(ppq, anchorVector), ppqPerSampleVector), tolerance);
+
+        _mm_storeu_pd(crossingSamples + n, ceil2(samples));
+        _mm_storeu_pd(crossingTurns + n, floor2(_mm_div_pd(crossingDegrees, fullTurn)));
+    }
+   #endif
+
+    // Whatever doesn't fill a whole vector (or everything, without SIMD)
+    for (; n < numDots; ++n)
+        computeCrossing(degrees[n], turns[n], rotation, degreesPerBeat, anchorPpq, ppqPerSample,
+                        crossingSamples[n], crossingTurns[n]);
+}
+
+const char* CrossingKernel::getInstructionSet() noexcept
+{
+   #if SKALD_CROSSING_AVX2
+    return "AVX2";
+   #elif SKALD_CROSSING_SSE2
+    return "SSE2";
+   #else
+    return "scalar";
+   #endif
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+
+//==============================================================================
+// The inner loop of the engine's sync timeline compiler: where every dot of one
+// rotation crosses the sensor while the platter follows the host's ppqPosition.
+//
+// Vectorised with AVX2 or SSE2 when the build targets them (AVX2 is opt-in, see
+// SKALD_AVX2 in CMakeLists.txt), with a scalar fallback elsewhere. Every path
+// rounds exactly like the scalar expression, so they all compile the same
+// timeline.
+struct CrossingKernel
+{
+    // For each of numDots dots: the crossing at degrees[n] + 360 * (rotation - turns[n])
+    // lands on sample ceil((crossing / degreesPerBeat - anchorPpq) / ppqPerSample - 1e-6)
+    // counted from the sync anchor, and belongs to turn floor(crossing / 360). Both are
+    // written as whole numbers. Never locks or allocates.
+    static void computeSyncCrossings(const double* degrees, const double* turns, size_t numDots,
+                                     double rotation, double degreesPerBeat, double anchorPpq,
+                                     double ppqPerSample, double* crossingSamples, double* crossingTurns) noexcept;
+
+    // "AVX2", "SSE2" or "scalar" - whichever this build uses
+    static const char* getInstructionSet() noexcept;
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cmath>
+
+//==============================================================================
+// Linear parameter glide, in samples (behaves like juce::SmoothedValue<float>
+// with linear smoothing, without pulling JUCE into the engine)
+class LinearSmoother
+{
+public:
+    explicit LinearSmoother(float initialValue = 0.0f) noexcept
+        : currentValue(initialValue), targetValue(initialValue) {}
+
+    // Sets the ramp length and jumps straight to the target
+    void reset(double sampleRate, double rampLengthSeconds) noexcept
+    {
+        stepsToTarget = static_cast<int>(std::floor(rampLengthSeconds * sampleRate));
+        currentValue = targetValue;
+        countdown = 0;
+    }
+
+    void setCurrentAndTargetValue(float newValue) noexcept
+    {
+        currentValue = targetValue = newValue;
+        countdown = 0;
+    }
+
+    void setTargetValue(float newValue) noexcept
+    {
+        if (newValue == targetValue)
+            return;
+
+        if (stepsToTarget <= 0)
+        {
+            setCurrentAndTargetValue(newValue);
+            return;
+        }
+
+        targetValue = newValue;
+        countdown = stepsToTarget;
+        step = (targetValue - currentValue) / static_cast<float>(countdown);
+    }
+
+    float getNextValue() noexcept
+    {
+        if (countdown <= 0)
+            return targetValue;
+
+        --countdown;
+        currentValue = countdown > 0 ? currentValue + step : targetValue;
+        return currentValue;
+    }
+
+    void skip(int numSamples) noexcept
+    {
+        if (numSamples >= countdown)
+        {
+            setCurrentAndTargetValue(targetValue);
+            return;
+        }
+
+        currentValue += step * static_cast<float>(numSamples);
+        countdown -= numSamples;
+    }
+
+    bool isSmoothing() const noexcept       { return countdown > 0; }
+    float getCurrentValue() const noexcept  { return currentValue; }
+    float getTargetValue() const noexcept   { return targetValue; }
+
+private:
+    float currentValue = 0.0f;
+    float targetValue = 0.0f;
+    float step = 0.0f;
+    int countdown = 0;
+    int stepsToTarget = 0;
+};
@@ -0,0 +1,126 @@
+#include "MidiFileWriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <tuple>
+
+namespace
+{
+    void writeBigEndian(std::vector<std::uint8_t>& out, std::uint32_t value, int numBytes)
+    {
+        for (int shift = (numBytes - 1) * 8; shift >= 0; shift -= 8)
+            out.push_back(static_cast<std::uint8_t>(value >> shift));
+    }
+
+    void writeVariableLength(std::vector<std::uint8_t>& out, std::uint32_t value)
+    {
+        std::uint8_t buffer[5];
+        int numBytes = 0;
+
+        do
+        {
+            buffer[numBytes++] = static_cast<std::uint8_t>(value & 0x7f);
+            value >>= 7;
+        }
+        while (value > 0);
+
+        // Most significant group first, with the continuation bit on all but the last
+        while (numBytes > 0)
+        {
+            --numBytes;
+            out.push_back(static_cast<std::uint8_t>(buffer[numBytes] | (numBytes > 0 ? 0x80 : 0x00)));
+        }
+    }
+}
+
+//==============================================================================
+MidiFileWriter::MidiFileWriter(double newSampleRate, double newBpm)
+    : sampleRate(newSampleRate), bpm(newBpm)
+{
+}
+
+void MidiFileWriter::addNoteOn(std::int64_t samplePosition, int channel, int midiNote, int velocity)
+{
+    const int ch = std::clamp(channel, 1, 16) - 1;
+    const int note = std::clamp(midiNote, 0, 127);
+
+    events.push_back({ samplePosition, static_cast<std::uint8_t>(0x90 | ch),
+                       static_cast<std::uint8_t>(note), static_cast<std::uint8_t>(std::clamp(velocity, 1, 127)) });
+    ++heldNotes[ch][note];
+}
+
+void MidiFileWriter::addNoteOff(std::int64_t samplePosition, int channel, int midiNote)
+{
+    const int ch = std::clamp(channel, 1, 16) - 1;
+    const int note = std::clamp(midiNote, 0, 127);
+
+    events.push_back({ samplePosition, static_cast<std::uint8_t>(0x80 | ch), static_cast<std::uint8_t>(note), 0 });
+    heldNotes[ch][note] = std::max(0, heldNotes[ch][note] - 1);
+}
+
+void MidiFileWriter::releaseHeldNotes(std::int64_t samplePosition)
+{
+    for (int ch = 0; ch < 16; ++ch)
+        for (int note = 0; note < 128; ++note)
+            while (heldNotes[ch][note] > 0)
+                addNoteOff(samplePosition, ch + 1, note);
+}
+
+std::vector<std::uint8_t> MidiFileWriter::toBytes() const
+{
+    auto sorted = events;
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Event& a, const Event& b)
+    {
+        // Note-offs first, then by channel, note and velocity - a total order, so the bytes
+        // don't depend on the order the events were added in
+        const auto key = [](const Event& e)
+        {
+            return std::make_tuple(e.samplePosition, (e.status & 0xf0) == 0x90, e.status, e.data1, e.data2);
+        };
+
+        return key(a) < key(b);
+    });
+
+    const double ticksPerSample = bpm * ticksPerQuarterNote / (60.0 * sampleRate);
+
+    std::vector<std::uint8_t> track;
+
+    // Tempo and a 4/4 time signature at tick 0
+    const auto microsecondsPerQuarter = static_cast<std::uint32_t>(std::llround(60000000.0 / bpm));
+    track.insert(track.end(), { 0x00, 0xff, 0x51, 0x03 });
+    writeBigEndian(track, microsecondsPerQuarter, 3);
+    track.insert(track.end(), { 0x00, 0xff, 0x58, 0x04, 0x04, 0x02, 0x18, 0x08 });
+
+    std::int64_t previousTick = 0;
+    for (const auto& event : sorted)
+    {
+        const auto tick = std::max(previousTick, static_cast<std::int64_t>(std::llround(static_cast<double>(event.samplePosition) * ticksPerSample)));
+        writeVariableLength(track, static_cast<std::uint32_t>(tick - previousTick));
+        track.insert(track.end(), { event.status, event.data1, event.data2 });
+        previousTick = tick;
+    }
+
+    // End of track
+    track.insert(track.end(), { 0x00, 0xff, 0x2f, 0x00 });
+
+    std::vector<std::uint8_t> file { 'M', 'T', 'h', 'd' };
+    writeBigEndian(file, 6, 4);
+    writeBigEndian(file, 0, 2);  // Format 0
+    writeBigEndian(file, 1, 2);  // One track
+    writeBigEndian(file, ticksPerQuarterNote, 2);
+
+    file.insert(file.end(), { 'M', 'T', 'r', 'k' });
+    writeBigEndian(file, static_cast<std::uint32_t>(track.size()), 4);
+    file.insert(file.end(), track.begin(), track.end());
+    return file;
+}
+
+bool MidiFileWriter::writeTo(const std::string& path) const
+{
+    const auto bytes = toBytes();
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
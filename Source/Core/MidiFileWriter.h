@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//==============================================================================
+// Builds a format 0 Standard MIDI File at a single fixed tempo. Events are
+// added in samples and converted to ticks when the file is written.
+class MidiFileWriter
+{
+public:
+    static constexpr int ticksPerQuarterNote = 960;
+
+    MidiFileWriter(double sampleRate, double bpm);
+
+    void addNoteOn(std::int64_t samplePosition, int channel, int midiNote, int velocity);
+    void addNoteOff(std::int64_t samplePosition, int channel, int midiNote);
+
+    // Note-offs for anything still sounding, at samplePosition
+    void releaseHeldNotes(std::int64_t samplePosition);
+
+    int getNumEvents() const { return static_cast<int>(events.size()); }
+
+    // The complete file. Events are ordered by time; at the same sample, note-offs
+    // come before note-ons so a retriggered note isn't cut short, and otherwise by
+    // channel, note and velocity, so the bytes never depend on the order events
+    // were added in.
+    std::vector<std::uint8_t> toBytes() const;
+    bool writeTo(const std::string& path) const;
+
+private:
+    struct Event
+    {
+        std::int64_t samplePosition;
+        std::uint8_t status;
+        std::uint8_t data1;
+        std::uint8_t data2;
+    };
+
+    double sampleRate;
+    double bpm;
+    std::vector<Event> events;
+    int heldNotes[16][128] = {};  // Note-ons not yet matched by a note-off
+};
@@ -0,0 +1,65 @@
+#include "OfflineRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Writes the engine's notes straight into the file at absolute sample positions
+    struct MidiFileSink : EngineEventSink
+    {
+        explicit MidiFileSink(MidiFileWriter& destination) : writer(destination) {}
+
+        void noteOn(int sampleInBlock, int channel, int midiNote, int velocity) override
+        {
+            writer.addNoteOn(blockStart + sampleInBlock, channel, midiNote, velocity);
+        }
+
+        void noteOff(int sampleInBlock, int channel, int midiNote) override
+        {
+            writer.addNoteOff(blockStart + sampleInBlock, channel, midiNote);
+        }
+
+        void dotPassed(const TriggerEvent&) override {}
+
+        MidiFileWriter& writer;
+        std::int64_t blockStart = 0;
+    };
+}
+
+MidiFileWriter renderPattern(const PatternFile& pattern, const RenderSettings& settings)
+{
+    MidiFileWriter writer(settings.sampleRate, settings.bpm);
+    MidiFileSink sink(writer);
+
+    const int blockSize = std::max(1, settings.blockSize);
+    const auto totalSamples = static_cast<std::int64_t>(std::llround(settings.bars * 4.0 * 60.0 / settings.bpm
+                                                                      * settings.sampleRate));
+
+    SkaldEngine engine;
+    engine.prepare(settings.sampleRate, blockSize, pattern.parameters);
+    engine.setRandomSeed(settings.seed);
+    engine.getScaleSystem().setScale(pattern.scale);
+    engine.getScaleSystem().setRootNote(pattern.rootNote);
+    engine.publishPattern(pattern.dots);
+
+    // A host transport rolling from bar 1 at a constant tempo
+    TransportState transport;
+    transport.bpm = settings.bpm;
+    transport.isPlaying = true;
+    transport.isHostPlaying = true;
+    transport.hasPpqPosition = true;
+
+    for (std::int64_t position = 0; position < totalSamples; position += blockSize)
+    {
+        const int numSamples = static_cast<int>(std::min<std::int64_t>(blockSize, totalSamples - position));
+        transport.ppqPosition = static_cast<double>(position) * settings.bpm / (60.0 * settings.sampleRate);
+
+        sink.blockStart = position;
+        engine.process(numSamples, transport, pattern.parameters, sink);
+    }
+
+    writer.releaseHeldNotes(totalSamples);
+    engine.collectGarbage();
+    return writer;
+}
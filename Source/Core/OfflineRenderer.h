@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include "MidiFileWriter.h"
+#include "PatternFile.h"
+
+//==============================================================================
+// How to play a pattern when rendering it without a host
+struct RenderSettings
+{
+    double bpm = 120.0;
+    int bars = 8;                   // 4/4 bars, from the top of bar 1
+    double sampleRate = 48000.0;
+    std::int64_t seed = 1;          // Probability / velocity variation stream
+    int blockSize = 512;            // The file is byte-identical at any block size
+};
+
+// Runs the engine over the pattern as fast as the CPU allows, as if a host were
+// playing from bar 1, and returns the notes it played. Anything still sounding
+// at the end is released there.
+MidiFileWriter renderPattern(const PatternFile& pattern, const RenderSettings& settings);
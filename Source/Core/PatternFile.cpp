@@ -0,0 +1,121 @@
+#include "PatternFile.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+    // Little-endian reader matching juce::MemoryOutputStream's encoding
+    class StateReader
+    {
+    public:
+        StateReader(const void* data, size_t size)
+            : bytes(static_cast<const std::uint8_t*>(data)), numBytes(size) {}
+
+        bool isExhausted() const { return position >= numBytes; }
+        bool hasFailed() const   { return failed; }
+
+        std::int32_t readInt()
+        {
+            if (numBytes - position < 4)
+            {
+                failed = true;
+                position = numBytes;
+                return 0;
+            }
+
+            const std::uint32_t value = static_cast<std::uint32_t>(bytes[position])
+                                      | static_cast<std::uint32_t>(bytes[position + 1]) << 8
+                                      | static_cast<std::uint32_t>(bytes[position + 2]) << 16
+                                      | static_cast<std::uint32_t>(bytes[position + 3]) << 24;
+            position += 4;
+
+            std::int32_t result;
+            std::memcpy(&result, &value, sizeof(result));
+            return result;
+        }
+
+        float readFloat()
+        {
+            const std::int32_t bits = readInt();
+            float result;
+            std::memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+        bool readBool()
+        {
+            if (position >= numBytes)
+            {
+                failed = true;
+                return false;
+            }
+
+            return bytes[position++] != 0;
+        }
+
+    private:
+        const std::uint8_t* bytes;
+        size_t numBytes;
+        size_t position = 0;
+        bool failed = false;
+    };
+}
+
+bool PatternFile::parse(const void* data, size_t size, PatternFile& result)
+{
+    StateReader stream(data, size);
+
+    result = PatternFile();
+    result.parameters.speed = stream.readFloat();
+    result.scale = static_cast<ScaleType>(stream.readInt());
+    result.rootNote = stream.readInt();
+
+    const int numDots = stream.readInt();
+
+    // Each dot takes 13 bytes, so a count the data can't hold is corrupt
+    if (stream.hasFailed() || numDots < 0 || static_cast<size_t>(numDots) > size / 13)
+        return false;
+
+    result.dots.reserve(static_cast<size_t>(numDots));
+    for (int i = 0; i < numDots; ++i)
+    {
+        PatternDot dot;
+        dot.angle = stream.readFloat();
+        dot.ringIndex = stream.readInt();
+        stream.readInt();  // Colour
+        dot.active = stream.readBool();
+        result.dots.push_back(dot);
+    }
+
+    if (stream.hasFailed())
+        return false;
+
+    // Parameters added later (older saved states stop before them)
+    if (!stream.isExhausted())
+    {
+        result.parameters.velocity = stream.readInt();
+        result.parameters.gateTimeMs = stream.readFloat();
+        result.parameters.reverse = stream.readBool();
+        result.parameters.probability = stream.readFloat();
+        result.parameters.velocityVariation = stream.readFloat();
+        result.parameters.swing = stream.readFloat();
+    }
+
+    if (!stream.isExhausted())
+        result.parameters.hostSync = stream.readBool();
+
+    return !stream.hasFailed();
+}
+
+bool PatternFile::load(const std::string& path, PatternFile& result)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+
+    const std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return parse(data.data(), data.size(), result);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "PatternSnapshot.h"
+#include "ScaleSystem.h"
+#include "SkaldEngine.h"
+
+//==============================================================================
+// A saved pattern (.ttp): the state blob written by
+// SkaldProcessor::getStateInformation, read without JUCE. All values are
+// little-endian; dot colours are skipped.
+struct PatternFile
+{
+    EngineParameters parameters;
+    ScaleType scale = ScaleType::Pentatonic;
+    int rootNote = 0;
+    std::vector<PatternDot> dots;
+
+    // Returns false if the data is truncated or malformed (result is then unspecified)
+    static bool parse(const void* data, size_t size, PatternFile& result);
+    static bool load(const std::string& path, PatternFile& result);
+};
@@ -0,0 +1,160 @@
+#include "PatternSnapshot.h"
+
+//==============================================================================
+PatternSnapshot::PatternSnapshot(std::vector<PatternDot> patternDots)
+    : dots(withIds(std::move(patternDots))),
+      triggeredThisRotation(dots.size(), false)
+{
+    // Id -> index lookup, so trigger state can follow dots across snapshots
+    for (size_t i = 0; i < dots.size(); ++i)
+    {
+        const auto slot = SlotMap<PatternDot>::getSlot(dots[i].id);
+        if (slot >= indexBySlot.size())
+            indexBySlot.resize(slot + 1, -1);
+
+        indexBySlot[slot] = static_cast<int>(i);
+    }
+
+    // Build the angle-sorted index of active dots used for crossing detection
+    auto& indices = sorted.indices;
+    indices.reserve(dots.size());
+    for (size_t i = 0; i < dots.size(); ++i)
+        if (dots[i].active)
+            indices.push_back(i);
+
+    std::stable_sort(indices.begin(), indices.end(), [this](size_t a, size_t b)
+    {
+        return normaliseAngle(dots[a].angle) < normaliseAngle(dots[b].angle);
+    });
+
+    sorted.ids.reserve(indices.size());
+    sorted.angles.reserve(indices.size());
+    sorted.phases.reserve(indices.size());
+    sorted.rings.reserve(indices.size());
+    sorted.degrees.reserve(indices.size());
+    sorted.turns.reserve(indices.size());
+    for (auto index : indices)
+    {
+        const auto& dot = dots[index];
+        sorted.ids.push_back(dot.id);
+        sorted.angles.push_back(normaliseAngle(dot.angle));
+        sorted.phases.push_back(angleToPhase(dot.angle));
+        sorted.rings.push_back(dot.ringIndex);
+        sorted.degrees.push_back(dot.angle);
+        sorted.turns.push_back(std::floor(static_cast<double>(dot.angle) / 360.0));
+    }
+
+    timeline.resize(indices.size());
+    crossingSamples.resize(indices.size());
+    crossingTurns.resize(indices.size());
+}
+
+std::vector<PatternDot> PatternSnapshot::withIds(std::vector<PatternDot> patternDots)
+{
+    // Patterns that don't come from a slot map (files, tools) are keyed by position
+    for (size_t i = 0; i < patternDots.size(); ++i)
+        if (patternDots[i].id == invalidDotId)
+            patternDots[i].id = static_cast<DotId>(i);
+
+    return patternDots;
+}
+
+int PatternSnapshot::findDot(DotId id) const noexcept
+{
+    const auto slot = SlotMap<PatternDot>::getSlot(id);
+    if (slot >= indexBySlot.size())
+        return -1;
+
+    const int index = indexBySlot[slot];
+    return index >= 0 && dots[static_cast<size_t>(index)].id == id ? index : -1;
+}
+
+float PatternSnapshot::normaliseAngle(float angle) noexcept
+{
+    angle = std::fmod(angle, 360.0f);
+    if (angle < 0.0f)
+        angle += 360.0f;
+
+    // fmod of a tiny negative value can round back up to exactly 360
+    return angle >= 360.0f ? 0.0f : angle;
+}
+
+std::uint64_t PatternSnapshot::angleToPhase(float angle) noexcept
+{
+    // Monotonic in the angle, so sorted.phases stays in the same order as sorted.angles
+    auto turns = static_cast<double>(normaliseAngle(angle)) / 360.0;
+    return static_cast<std::uint64_t>(std::ldexp(turns, 32)) << 32;
+}
+
+std::uint64_t PatternSnapshot::degreesToPhase(double degrees) noexcept
+{
+    double turns = degrees / 360.0;
+    turns -= std::floor(turns);
+
+    // Rounding can leave a tiny negative angle at exactly one turn
+    if (turns >= 1.0)
+        turns = 0.0;
+
+    return static_cast<std::uint64_t>(std::ldexp(turns, 64));
+}
+
+float PatternSnapshot::phaseToAngle(std::uint64_t phase) noexcept
+{
+    return normaliseAngle(static_cast<float>(std::ldexp(static_cast<double>(phase), -64) * 360.0));
+}
+
+void PatternSnapshot::clearTriggers() noexcept
+{
+    std::fill(triggeredThisRotation.begin(), triggeredThisRotation.end(), false);
+}
+
+void PatternSnapshot::inheritTriggers(const PatternSnapshot& previous) noexcept
+{
+    for (size_t i = 0; i < dots.size(); ++i)
+    {
+        const int previousIndex = previous.findDot(dots[i].id);
+        triggeredThisRotation[i] = previousIndex >= 0 && previous.triggeredThisRotation[static_cast<size_t>(previousIndex)];
+    }
+}
+
+//==============================================================================
+PatternSnapshotExchange::~PatternSnapshotExchange()
+{
+    delete pending.exchange(nullptr);
+    delete retired.exchange(nullptr);
+    delete current;
+}
+
+void PatternSnapshotExchange::publish(std::unique_ptr<PatternSnapshot> snapshot)
+{
+    collectGarbage();
+
+    // Anything still pending was never seen by the audio thread, so it is safe to free
+    delete pending.exchange(snapshot.release(), std::memory_order_acq_rel);
+}
+
+void PatternSnapshotExchange::collectGarbage()
+{
+    delete retired.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+PatternSnapshot* PatternSnapshotExchange::acquire() noexcept
+{
+    // Only swap when the retired slot is free - the message thread is the only one
+    // that empties it, so the store below can never overwrite an uncollected snapshot.
+    // If it is still full we simply keep the current snapshot for one more block.
+    if (retired.load(std::memory_order_acquire) != nullptr)
+        return current;
+
+    if (auto* next = pending.exchange(nullptr, std::memory_order_acq_rel))
+    {
+        // Carry trigger state across the swap so an edit mid-rotation doesn't re-fire dots
+        if (current != nullptr)
+            next->inheritTriggers(*current);
+
+        retired.store(current, std::memory_order_release);
+        current = next;
+    }
+
+    return current;
+}
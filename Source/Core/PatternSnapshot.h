@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "SlotMap.h"
+
+struct PatternDot;
+
+// Stable handle to a dot, issued by the slot map that owns the pattern. Survives
+// other dots being added or removed, unlike the dot's position in the pattern.
+using DotId = SlotMap<PatternDot>::Id;
+constexpr DotId invalidDotId = SlotMap<PatternDot>::invalidId;
+
+// The sequencing-relevant part of a turntable dot (colour lives with the UI)
+struct PatternDot
+{
+    float angle = 0.0f;   // Position on the turntable (0-360 degrees)
+    int ringIndex = 0;    // Which ring (0-11) - determines pitch in scale
+    bool active = true;   // Whether this dot is active
+    DotId id = invalidDotId; // Left invalid, the snapshot uses the dot's position
+};
+
+// One dot crossing compiled into the engine's sync timeline: when it happens and
+// what it plays, with the random decisions already made
+struct TimelineEvent
+{
+    std::int64_t sample = 0;         // Crossing, in samples from the sync anchor
+    int dotIndex = 0;
+    DotId dotId = invalidDotId;
+    int ringIndex = 0;
+    bool passedProbability = false;
+    int velocity = 0;                // After variation
+    int swingOffset = 0;             // Samples the note-on is delayed by swing
+};
+
+//==============================================================================
+// Immutable copy of the pattern as seen by the audio thread.
+// Built on the message thread and never modified after it has been published,
+// except for triggeredThisRotation and the timeline, which are scratch space owned
+// by the audio callback that currently holds the snapshot (allocated here so
+// the audio thread never has to).
+struct PatternSnapshot
+{
+    explicit PatternSnapshot(std::vector<PatternDot> patternDots);
+
+    void clearTriggers() noexcept;
+
+    // Takes over previous's triggeredThisRotation for every dot both snapshots share,
+    // matched by id, so an edit mid-rotation neither re-fires nor silences a dot. O(n);
+    // never locks or allocates.
+    void inheritTriggers(const PatternSnapshot& previous) noexcept;
+
+    // Index into dots of the dot with this id, or -1. O(1).
+    int findDot(DotId id) const noexcept;
+
+    // Calls callback(dotIndex) for every active dot inside the arc that starts at
+    // arcStart (degrees) and spans arcLength degrees - positive for clockwise
+    // (increasing angle), negative for reverse. Dots are visited in the order the
+    // sensor passes them. O(log n + k) thanks to the angle-sorted index.
+    template <typename Callback>
+    void forEachDotInArc(float arcStart, float arcLength, Callback&& callback) const
+    {
+        const auto numSorted = sorted.angles.size();
+        if (numSorted == 0)
+            return;
+
+        // A full turn (or more) passes every dot exactly once
+        if (std::abs(arcLength) >= 360.0f)
+        {
+            for (size_t n = 0; n < numSorted; ++n)
+                callback(sorted.indices[n]);
+            return;
+        }
+
+        const auto begin = sorted.angles.begin();
+        const auto end = sorted.angles.end();
+        const float start = normaliseAngle(arcStart);
+
+        auto emitRange = [&](auto first, auto last, bool ascending)
+        {
+            auto from = static_cast<size_t>(first - begin);
+            auto to = static_cast<size_t>(last - begin);
+
+            if (ascending)
+                for (size_t n = from; n < to; ++n)
+                    callback(sorted.indices[n]);
+            else
+                for (size_t n = to; n > from; --n)
+                    callback(sorted.indices[n - 1]);
+        };
+
+        if (arcLength >= 0.0f)
+        {
+            const float stop = start + arcLength;
+            emitRange(std::lower_bound(begin, end, start),
+                      std::upper_bound(begin, end, std::min(stop, 360.0f)), true);
+
+            // Arc wraps past 360° - continue from 0°
+            if (stop >= 360.0f)
+                emitRange(begin, std::upper_bound(begin, end, stop - 360.0f), true);
+        }
+        else
+        {
+            const float stop = start + arcLength;
+            emitRange(std::lower_bound(begin, end, std::max(stop, 0.0f)),
+                      std::upper_bound(begin, end, start), false);
+
+            // Arc wraps below 0° - continue down from 360°
+            if (stop < 0.0f)
+                emitRange(std::lower_bound(begin, end, stop + 360.0f), end, false);
+        }
+    }
+
+    // Calls callback(dotIndex, distance) for every active dot the sensor reaches when
+    // it travels phaseLength from startPhase (forwards, or backwards when !forward).
+    // The range is half-open - a dot exactly at startPhase is included, one exactly at
+    // the far end is left for the next block - and distance is how far the sensor
+    // travels before reaching the dot. Pure integer arithmetic, no tolerance needed.
+    template <typename Callback>
+    void forEachDotInPhaseRange(std::uint64_t startPhase, std::uint64_t phaseLength,
+                                bool forward, Callback&& callback) const
+    {
+        if (sorted.phases.empty() || phaseLength == 0)
+            return;
+
+        const auto begin = sorted.phases.begin();
+        const auto end = sorted.phases.end();
+
+        auto emitRange = [&](auto first, auto last)
+        {
+            auto from = static_cast<size_t>(first - begin);
+            auto to = static_cast<size_t>(last - begin);
+
+            if (forward)
+                for (size_t n = from; n < to; ++n)
+                    callback(sorted.indices[n], sorted.phases[n] - startPhase);
+            else
+                for (size_t n = to; n > from; --n)
+                    callback(sorted.indices[n - 1], startPhase - sorted.phases[n - 1]);
+        };
+
+        if (forward)
+        {
+            // [startPhase, stopPhase), continuing from 0 if it wraps
+            const std::uint64_t stopPhase = startPhase + phaseLength;
+            if (stopPhase > startPhase)
+            {
+                emitRange(std::lower_bound(begin, end, startPhase), std::lower_bound(begin, end, stopPhase));
+            }
+            else
+            {
+                emitRange(std::lower_bound(begin, end, startPhase), end);
+                emitRange(begin, std::lower_bound(begin, end, stopPhase));
+            }
+        }
+        else
+        {
+            // [lowestPhase, startPhase] visited downwards, continuing from the top if it wraps
+            const std::uint64_t lowestPhase = startPhase - (phaseLength - 1);
+            if (lowestPhase <= startPhase)
+            {
+                emitRange(std::lower_bound(begin, end, lowestPhase), std::upper_bound(begin, end, startPhase));
+            }
+            else
+            {
+                emitRange(begin, std::upper_bound(begin, end, startPhase));
+                emitRange(std::lower_bound(begin, end, lowestPhase), end);
+            }
+        }
+    }
+
+    // The active dots in angle order - the order the sensor passes them turning
+    // forwards - held as parallel arrays, so passes over the whole pattern on the
+    // audio thread read contiguous memory instead of striding through dots
+    struct SortedDots
+    {
+        std::vector<size_t> indices;          // Into dots
+        std::vector<DotId> ids;
+        std::vector<float> angles;            // Normalised angle (degrees)
+        std::vector<std::uint64_t> phases;    // angles in the fixed-point phase domain
+        std::vector<int> rings;
+        std::vector<double> degrees;          // Angle as stored (may be outside 0-360)
+        std::vector<double> turns;            // floor(degrees / 360)
+
+        size_t size() const noexcept { return indices.size(); }
+    };
+
+    const SortedDots& getSortedDots() const noexcept { return sorted; }
+
+    // Wraps any angle into [0, 360)
+    static float normaliseAngle(float angle) noexcept;
+
+    // Fixed-point rotation phase: a uint64 where 2^64 is one full turn, so wrapping is
+    // free and exact. Dot angles land on whole multiples of 2^32 (the upper 32 bits).
+    static std::uint64_t angleToPhase(float angle) noexcept;
+    static std::uint64_t degreesToPhase(double degrees) noexcept;
+    static float phaseToAngle(std::uint64_t phase) noexcept;
+
+    const std::vector<PatternDot> dots;
+    std::vector<bool> triggeredThisRotation;
+    std::vector<TimelineEvent> timeline;  // One rotation's crossings, one per active dot
+    std::vector<double> crossingSamples;  // Compiler scratch, in SortedDots order
+    std::vector<double> crossingTurns;
+
+private:
+    // Rebuilt only when a new snapshot is built (i.e. when the pattern changes)
+    SortedDots sorted;
+    std::vector<int> indexBySlot;         // Slot of a dot's id -> index into dots, or -1
+
+    static std::vector<PatternDot> withIds(std::vector<PatternDot> patternDots);
+};
+
+//==============================================================================
+// Single-producer/single-consumer handoff of pattern snapshots (RCU-style).
+//
+// The message thread publishes complete snapshots; the audio thread swaps the
+// newest one in at the top of a block with a single atomic exchange. Ownership
+// moves through three slots (pending -> current -> retired) so that a snapshot
+// is only ever freed on the message thread, once the audio thread has let go
+// of it.
+class PatternSnapshotExchange
+{
+public:
+    PatternSnapshotExchange() = default;
+    ~PatternSnapshotExchange();
+
+    PatternSnapshotExchange(const PatternSnapshotExchange&) = delete;
+    PatternSnapshotExchange& operator=(const PatternSnapshotExchange&) = delete;
+
+    // Message thread: make a new snapshot visible to the audio thread. A
+    // previously published snapshot that was never picked up is freed here.
+    void publish(std::unique_ptr<PatternSnapshot> snapshot);
+
+    // Message thread: free the snapshot the audio thread has swapped out.
+    void collectGarbage();
+
+    // Audio thread: returns the snapshot to use for this block (may be null
+    // before the first publish). Never locks, allocates or frees.
+    PatternSnapshot* acquire() noexcept;
+
+private:
+    std::atomic<PatternSnapshot*> pending { nullptr };
+    std::atomic<PatternSnapshot*> retired { nullptr };
+    PatternSnapshot* current = nullptr;  // Audio thread only
+};
@@ -0,0 +1,233 @@
+#include "RealtimeCheck.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+ #include <malloc.h>
+#endif
+
+#if defined(__linux__)
+ #include <dlfcn.h>
+ #include <pthread.h>
+ #include <semaphore.h>
+ #include <time.h>
+ #include <unistd.h>
+#endif
+
+//==============================================================================
+namespace
+{
+    thread_local int realtimeDepth = 0;
+    thread_local bool isReporting = false;  // Suppresses checks made by the reporter itself
+
+    std::atomic<long long> violationCount { 0 };
+    std::atomic<long long> allocationCount { 0 };
+    std::atomic<bool> abortOnViolation { std::getenv("SKALD_RT_CHECK_ABORT") != nullptr };
+
+    bool shouldCheck() noexcept
+    {
+        return realtimeDepth > 0 && !isReporting;
+    }
+}
+
+RealtimeCheck::ScopedSection::ScopedSection() noexcept   { ++realtimeDepth; }
+RealtimeCheck::ScopedSection::~ScopedSection() noexcept  { --realtimeDepth; }
+
+bool RealtimeCheck::isInRealtimeSection() noexcept
+{
+    return realtimeDepth > 0;
+}
+
+void RealtimeCheck::reportViolation(const char* what) noexcept
+{
+    if (!shouldCheck())
+        return;
+
+    isReporting = true;
+    violationCount.fetch_add(1, std::memory_order_relaxed);
+    std::fprintf(stderr, "SKALD_RT_CHECK: %s inside a real-time section\n", what);
+
+    if (abortOnViolation.load(std::memory_order_relaxed))
+        std::abort();
+
+    isReporting = false;
+}
+
+long long RealtimeCheck::getViolationCount() noexcept   { return violationCount.load(); }
+long long RealtimeCheck::getAllocationCount() noexcept  { return allocationCount.load(); }
+
+void RealtimeCheck::setAbortOnViolation(bool shouldAbort) noexcept
+{
+    abortOnViolation.store(shouldAbort);
+}
+
+//==============================================================================
+// Heap allocation: every global operator new/delete is routed through here, and on
+// glibc so are malloc, calloc, realloc and free (forwarded to glibc's own
+// implementations, which - unlike dlsym - never allocate to look themselves up)
+#if defined(__GLIBC__)
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* p, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void* p);
+}
+#endif
+
+namespace
+{
+    void checkAllocation() noexcept
+    {
+        if (shouldCheck())
+        {
+            allocationCount.fetch_add(1, std::memory_order_relaxed);
+            RealtimeCheck::reportViolation("heap allocation");
+        }
+    }
+
+    void checkDeallocation(void* p) noexcept
+    {
+        if (p != nullptr)
+            RealtimeCheck::reportViolation("heap deallocation");
+    }
+
+    void* rawAllocate(std::size_t size, std::size_t alignment) noexcept
+    {
+       #if defined(__GLIBC__)
+        return alignment <= alignof(std::max_align_t) ? __libc_malloc(size) : __libc_memalign(alignment, size);
+       #elif defined(_WIN32)
+        return alignment <= alignof(std::max_align_t) ? std::malloc(size) : _aligned_malloc(size, alignment);
+       #else
+        void* p = nullptr;
+        return alignment <= alignof(std::max_align_t) ? std::malloc(size)
+                                                      : (posix_memalign(&p, alignment, size) == 0 ? p : nullptr);
+       #endif
+    }
+
+    void rawFree(void* p, std::size_t alignment) noexcept
+    {
+       #if defined(__GLIBC__)
+        (void) alignment;
+        __libc_free(p);
+       #elif defined(_WIN32)
+        if (alignment <= alignof(std::max_align_t))
+            std::free(p);
+        else
+            _aligned_free(p);
+       #else
+        (void) alignment;
+        std::free(p);
+       #endif
+    }
+
+    void* checkedAllocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t))
+    {
+        checkAllocation();
+
+        if (void* p = rawAllocate(size == 0 ? 1 : size, alignment))
+            return p;
+
+        throw std::bad_alloc();
+    }
+
+    void* checkedAllocateNoThrow(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) noexcept
+    {
+        checkAllocation();
+        return rawAllocate(size == 0 ? 1 : size, alignment);
+    }
+
+    void checkedFree(void* p, std::size_t alignment = alignof(std::max_align_t)) noexcept
+    {
+        checkDeallocation(p);
+        rawFree(p, alignment);
+    }
+
+    std::size_t toSize(std::align_val_t alignment) noexcept
+    {
+        return static_cast<std::size_t>(alignment);
+    }
+}
+
+void* operator new(std::size_t size)                                   { return checkedAllocate(size); }
+void* operator new[](std::size_t size)                                 { return checkedAllocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept   { return checkedAllocateNoThrow(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return checkedAllocateNoThrow(size); }
+void operator delete(void* p) noexcept                                 { checkedFree(p); }
+void operator delete[](void* p) noexcept                               { checkedFree(p); }
+void operator delete(void* p, std::size_t) noexcept                    { checkedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept                  { checkedFree(p); }
+
+// Over-aligned types (alignas larger than the default) come through these
+void* operator new(std::size_t size, std::align_val_t a)                                   { return checkedAllocate(size, toSize(a)); }
+void* operator new[](std::size_t size, std::align_val_t a)                                 { return checkedAllocate(size, toSize(a)); }
+void* operator new(std::size_t size, std::align_val_t a, const std::nothrow_t&) noexcept   { return checkedAllocateNoThrow(size, toSize(a)); }
+void* operator new[](std::size_t size, std::align_val_t a, const std::nothrow_t&) noexcept { return checkedAllocateNoThrow(size, toSize(a)); }
+void operator delete(void* p, std::align_val_t a) noexcept                                 { checkedFree(p, toSize(a)); }
+void operator delete[](void* p, std::align_val_t a) noexcept                               { checkedFree(p, toSize(a)); }
+void operator delete(void* p, std::size_t, std::align_val_t a) noexcept                    { checkedFree(p, toSize(a)); }
+void operator delete[](void* p, std::size_t, std::align_val_t a) noexcept                  { checkedFree(p, toSize(a)); }
+
+#if defined(__GLIBC__)
+extern "C" void* malloc(size_t size) noexcept
+{
+    checkAllocation();
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size) noexcept
+{
+    checkAllocation();
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* p, size_t size) noexcept
+{
+    checkAllocation();
+    return __libc_realloc(p, size);
+}
+
+extern "C" void free(void* p) noexcept
+{
+    checkDeallocation(p);
+    __libc_free(p);
+}
+#endif
+
+//==============================================================================
+// Locks and blocking system calls: on Linux these are interposed by defining the
+// libc symbols here and forwarding to the real ones. (Other platforms only get
+// the allocation check.) The exception specifications match glibc's declarations.
+#if defined(__linux__)
+
+#define SKALD_FORWARD_TO_LIBC(returnType, name, params, args, exceptionSpec)            \
+    extern "C" returnType name params exceptionSpec                                     \
+    {                                                                                   \
+        using Function = returnType (*) params;                                         \
+        static Function real = nullptr;                                                 \
+        if (real == nullptr)                                                            \
+            real = reinterpret_cast<Function>(dlsym(RTLD_NEXT, #name));                 \
+        RealtimeCheck::reportViolation(#name);                                          \
+        return real args;                                                               \
+    }
+
+SKALD_FORWARD_TO_LIBC(int, pthread_mutex_lock, (pthread_mutex_t* m), (m), noexcept)
+SKALD_FORWARD_TO_LIBC(int, pthread_rwlock_rdlock, (pthread_rwlock_t* l), (l), noexcept)
+SKALD_FORWARD_TO_LIBC(int, pthread_rwlock_wrlock, (pthread_rwlock_t* l), (l), noexcept)
+SKALD_FORWARD_TO_LIBC(int, pthread_cond_wait, (pthread_cond_t* c, pthread_mutex_t* m), (c, m), )
+SKALD_FORWARD_TO_LIBC(int, pthread_cond_timedwait, (pthread_cond_t* c, pthread_mutex_t* m, const struct timespec* t), (c, m, t), )
+SKALD_FORWARD_TO_LIBC(int, sem_wait, (sem_t* s), (s), )
+SKALD_FORWARD_TO_LIBC(int, nanosleep, (const struct timespec* req, struct timespec* rem), (req, rem), )
+SKALD_FORWARD_TO_LIBC(int, usleep, (useconds_t usec), (usec), )
+SKALD_FORWARD_TO_LIBC(unsigned int, sleep, (unsigned int seconds), (seconds), )
+SKALD_FORWARD_TO_LIBC(ssize_t, read, (int fd, void* buf, size_t count), (fd, buf, count), )
+SKALD_FORWARD_TO_LIBC(ssize_t, write, (int fd, const void* buf, size_t count), (fd, buf, count), )
+
+#undef SKALD_FORWARD_TO_LIBC
+
+#endif
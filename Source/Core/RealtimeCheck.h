@@ -0,0 +1,45 @@
+#pragma once
+
+//==============================================================================
+// Real-time safety checking for the audio path.
+//
+// Code that must never block is marked with SKALD_REALTIME_SCOPE. In a build
+// configured with -DSKALD_RT_CHECK=ON, any heap allocation, mutex acquisition or
+// blocking system call made on that thread while such a scope is open is counted
+// and logged to stderr (and aborts, for a debugger to catch, if the environment
+// variable SKALD_RT_CHECK_ABORT is set). In normal builds the macro is empty and
+// nothing is checked.
+#if SKALD_RT_CHECK
+
+class RealtimeCheck
+{
+public:
+    // Marks the enclosing scope as real-time; scopes may nest
+    struct ScopedSection
+    {
+        ScopedSection() noexcept;
+        ~ScopedSection() noexcept;
+
+        ScopedSection(const ScopedSection&) = delete;
+        ScopedSection& operator=(const ScopedSection&) = delete;
+    };
+
+    // True while the calling thread is inside a real-time scope
+    static bool isInRealtimeSection() noexcept;
+
+    // Counts (and logs) a forbidden call made from a real-time scope
+    static void reportViolation(const char* what) noexcept;
+
+    static long long getViolationCount() noexcept;
+    static long long getAllocationCount() noexcept;  // Heap allocations inside real-time scopes
+
+    static void setAbortOnViolation(bool shouldAbort) noexcept;
+};
+
+#define SKALD_REALTIME_SCOPE RealtimeCheck::ScopedSection skaldRealtimeSection
+
+#else
+
+#define SKALD_REALTIME_SCOPE do {} while (false)
+
+#endif
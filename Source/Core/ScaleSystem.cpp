@@ -0,0 +1,51 @@
+#include "ScaleSystem.h"
+
+#include <algorithm>
+
+//==============================================================================
+ScaleSystem::ScaleSystem()
+{
+    // Initialize scale (all three buffers, so the audio thread starts in key)
+    updateNoteTable();
+    noteTableBuffers.fill(noteTable);
+}
+
+void ScaleSystem::updateNoteTable()
+{
+    const auto& intervals = getScaleIntervals(currentScale);
+
+    // Single octave of the scale, shifted by whole octaves
+    int baseMIDI = rootNote + ((baseOctave + octaveShift) * 12);
+    noteTable.fill(60);
+    for (int ring = 0; ring < intervals.size; ++ring)
+        noteTable[static_cast<size_t>(ring)] = static_cast<std::uint8_t>(baseMIDI + intervals.semitones[static_cast<size_t>(ring)]);
+
+    noteTableBuffers[static_cast<size_t>(backIndex)] = noteTable;
+    backIndex = middleIndex.exchange(backIndex | freshFlag, std::memory_order_acq_rel) & ~freshFlag;
+}
+
+const ScaleSystem::NoteTable& ScaleSystem::acquireNoteTable() noexcept
+{
+    if ((middleIndex.load(std::memory_order_acquire) & freshFlag) != 0)
+        frontIndex = middleIndex.exchange(frontIndex, std::memory_order_acq_rel) & ~freshFlag;
+
+    return noteTableBuffers[static_cast<size_t>(frontIndex)];
+}
+
+void ScaleSystem::setScale(ScaleType newScale)
+{
+    currentScale = newScale;
+    updateNoteTable();
+}
+
+void ScaleSystem::setRootNote(int newRoot)
+{
+    rootNote = std::clamp(newRoot, 0, 11);
+    updateNoteTable();
+}
+
+void ScaleSystem::setOctaveShift(int shift)
+{
+    octaveShift = std::clamp(shift, -2, 2);
+    updateNoteTable();
+}
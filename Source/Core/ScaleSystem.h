@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+//==============================================================================
+// Scale types
+enum class ScaleType
+{
+    Major,
+    Minor,
+    HarmonicMinor,
+    MelodicMinor,
+    Pentatonic,
+    PentatonicMinor,
+    Blues,
+    Dorian,
+    Phrygian,
+    Lydian,
+    Mixolydian,
+    Locrian,
+    Chromatic
+};
+
+// A scale's notes as semitones above the root, ascending, within one octave
+struct ScaleIntervals
+{
+    constexpr ScaleIntervals(std::initializer_list<int> steps)
+    {
+        for (int step : steps)
+            semitones[static_cast<size_t>(size++)] = step;
+    }
+
+    std::array<int, 12> semitones {};
+    int size = 0;
+};
+
+//==============================================================================
+// Maps turntable rings onto the notes of the selected scale and key.
+//
+// The setters and ringToMidiNote belong to the message thread. The audio thread
+// reads its own copy of the ring -> note table through acquireNoteTable(), handed
+// over with a lock-free triple buffer, so scale, key and octave changes never race
+// the trigger path and never make it wait.
+class ScaleSystem
+{
+public:
+    // Ring index -> MIDI note for the current scale, key and octave. Rings past the
+    // end of the scale map to middle C.
+    using NoteTable = std::array<std::uint8_t, 128>;
+
+    ScaleSystem();
+
+    void setScale(ScaleType newScale);
+    void setRootNote(int newRoot); // 0-11 (C-B)
+    void setOctaveShift(int shift); // -2, -1, 0, +1, +2
+    ScaleType getScale() const { return currentScale; }
+    int getRootNote() const { return rootNote; }
+    int getOctaveShift() const { return octaveShift; }
+    int getNumRings() const { return getScaleIntervals(currentScale).size; }
+
+    // Convert ring index to MIDI note based on current scale/key
+    int ringToMidiNote(int ringIndex) const { return lookUpNote(noteTable, ringIndex); }
+
+    // Audio thread: the newest table the message thread has published. Never locks
+    // or allocates; call once per block and look notes up in the result.
+    const NoteTable& acquireNoteTable() noexcept;
+
+    static int lookUpNote(const NoteTable& table, int ringIndex) noexcept
+    {
+        return static_cast<size_t>(ringIndex) < table.size() ? table[static_cast<size_t>(ringIndex)] : 60;
+    }
+
+    // Get scale intervals
+    static constexpr const ScaleIntervals& getScaleIntervals(ScaleType scale)
+    {
+        const auto index = static_cast<size_t>(scale);
+        return index < scaleTables.size() ? scaleTables[index] : scaleTables[static_cast<size_t>(ScaleType::Pentatonic)];
+    }
+
+private:
+    // Every scale, built at compile time, in ScaleType order
+    static constexpr std::array<ScaleIntervals, 13> scaleTables {{
+        { 0, 2, 4, 5, 7, 9, 11 },                       // Major
+        { 0, 2, 3, 5, 7, 8, 10 },                       // Minor
+        { 0, 2, 3, 5, 7, 8, 11 },                       // HarmonicMinor
+        { 0, 2, 3, 5, 7, 9, 11 },                       // MelodicMinor
+        { 0, 2, 4, 7, 9 },                              // Pentatonic
+        { 0, 3, 5, 7, 10 },                             // PentatonicMinor
+        { 0, 3, 5, 6, 7, 10 },                          // Blues
+        { 0, 2, 3, 5, 7, 9, 10 },                       // Dorian
+        { 0, 1, 3, 5, 7, 8, 10 },                       // Phrygian
+        { 0, 2, 4, 6, 7, 9, 11 },                       // Lydian
+        { 0, 2, 4, 5, 7, 9, 10 },                       // Mixolydian
+        { 0, 1, 3, 5, 6, 8, 10 },                       // Locrian
+        { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 }        // Chromatic
+    }};
+
+    static_assert(static_cast<size_t>(ScaleType::Chromatic) + 1 == scaleTables.size(),
+                  "scaleTables needs one entry per ScaleType");
+
+    ScaleType currentScale = ScaleType::Pentatonic;
+    int rootNote = 0; // C
+    int baseOctave = 4; // C4 as base
+    int octaveShift = 0; // -2, -1, 0, +1, or +2 octave shift
+    NoteTable noteTable {}; // Message thread's table
+
+    // Triple buffer: the message thread fills the back table and swaps it into the
+    // middle slot marked fresh; the audio thread swaps a fresh middle slot for its
+    // front table. Each side only ever touches the table it holds.
+    static constexpr int freshFlag = 4;
+    std::array<NoteTable, 3> noteTableBuffers {};
+    int backIndex = 0;                    // Message thread
+    std::atomic<int> middleIndex { 1 };   // Table index, plus freshFlag once published
+    int frontIndex = 2;                   // Audio thread
+
+    // Rebuild the note table from the current settings and publish it
+    void updateNoteTable();
+};
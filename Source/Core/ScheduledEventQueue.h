@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+//==============================================================================
+// Fixed-capacity min-heap of timed events, ordered by EventType::samplePosition.
+//
+// Storage is allocated up front by reserve() (call it from prepareToPlay, never
+// from the audio thread); push/pop afterwards are O(log n) and never touch the
+// heap allocator. push() refuses events once the queue is full so the caller can
+// apply whatever overflow policy suits the event type.
+template <typename EventType>
+class ScheduledEventQueue
+{
+public:
+    // Grows the storage to hold at least maxEvents. Events already queued are kept.
+    void reserve(size_t maxEvents)
+    {
+        events.reserve(maxEvents);
+        capacity = maxEvents;
+    }
+
+    bool push(const EventType& event) noexcept
+    {
+        if (events.size() >= capacity)
+            return false;
+
+        events.push_back(event);  // Never reallocates: size < reserved capacity
+        std::push_heap(events.begin(), events.end(), isLater);
+        return true;
+    }
+
+    // Earliest event - only valid when the queue is not empty
+    const EventType& top() const noexcept { return events.front(); }
+
+    EventType pop() noexcept
+    {
+        std::pop_heap(events.begin(), events.end(), isLater);
+        auto event = events.back();
+        events.pop_back();
+        return event;
+    }
+
+    // Removes every event due before endSample, calling callback(event) in time order
+    template <typename Callback>
+    void popEventsBefore(long long endSample, Callback&& callback)
+    {
+        while (!events.empty() && top().samplePosition < endSample)
+            callback(pop());
+    }
+
+    void clear() noexcept             { events.clear(); }
+    bool isEmpty() const noexcept     { return events.empty(); }
+    bool isFull() const noexcept      { return events.size() >= capacity; }
+    size_t size() const noexcept      { return events.size(); }
+    size_t getCapacity() const noexcept { return capacity; }
+
+private:
+    static bool isLater(const EventType& a, const EventType& b) noexcept
+    {
+        return a.samplePosition > b.samplePosition;
+    }
+
+    std::vector<EventType> events;
+    size_t capacity = 0;
+};
@@ -0,0 +1,717 @@
+#include "SkaldEngine.h"
+#include "CrossingKernel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+//==============================================================================
+void SkaldEngine::prepare(double newSampleRate, int maxBlockSize, const EngineParameters& initialParameters)
+{
+    sampleRate = newSampleRate;
+
+    // Allocate the note-off scheduler up front (keeps any notes still sounding)
+    noteOffQueue.reserve(maxScheduledNoteOffs);
+    pendingNoteOnQueue.reserve(maxPendingNoteOns);
+
+    // Per-sample rotation offsets for speed ramps (larger blocks are done in chunks)
+    phaseOffsets.assign(static_cast<size_t>(std::max(1, maxBlockSize)) + 1, 0);
+
+    // ~50ms glide for automated speed/swing changes
+    speedSmoothed.reset(sampleRate, 0.05);
+    speedSmoothed.setCurrentAndTargetValue(initialParameters.speed);
+    swingSmoothed.reset(sampleRate, 0.05);
+    swingSmoothed.setCurrentAndTargetValue(initialParameters.swing);
+}
+
+void SkaldEngine::publishPattern(std::vector<PatternDot> dots)
+{
+    // The audio thread only ever sees complete, immutable copies of the pattern
+    patternExchange.publish(std::make_unique<PatternSnapshot>(std::move(dots)));
+}
+
+//==============================================================================
+void SkaldEngine::process(int numSamples, const TransportState& transport, const EngineParameters& params,
+                          EngineEventSink& sink, const PreviewNote* previews, int numPreviews)
+{
+    // An empty block has no sample to place a note at
+    if (numSamples <= 0)
+        return;
+
+    const int globalVelocity = params.velocity;
+    const float gateTimeMs = params.gateTimeMs;
+    const bool isReversed = params.reverse;
+    const bool motorRunning = params.motorRunning;
+    const float probability = params.probability;
+    const float velocityVariation = params.velocityVariation;
+
+    // Hosts deliver automation once per block, so speed and swing are smoothed across
+    // the block's samples. The free-running rotation steps the speed every sample;
+    // swing is interpolated between its start and end values at the trigger sample.
+    speedSmoothed.setTargetValue(params.speed);
+    bool speedSmoothingConsumed = false;
+
+    swingSmoothed.setTargetValue(params.swing);
+    const float swingAtBlockStart = swingSmoothed.getCurrentValue();
+    swingSmoothed.skip(numSamples);
+    const float swingAtBlockEnd = swingSmoothed.getCurrentValue();
+
+    // Pick up the latest pattern snapshot and note table (lock-free, never allocates)
+    PatternSnapshot* pattern = patternExchange.acquire();
+    const auto& noteTable = scaleSystem.acquireNoteTable();
+
+    // Process scheduled note-offs first (notes that should end in this buffer), in time order
+    noteOffQueue.popEventsBefore(totalSamplesProcessed + numSamples,
+        [this, &sink](const ScheduledNoteOff& note)
+        {
+            // Anything overdue is sent at the start of the buffer rather than dropped
+            auto noteOffInBuffer = std::max(std::int64_t(0), note.samplePosition - totalSamplesProcessed);
+            sink.noteOff(static_cast<int>(noteOffInBuffer), note.channel, note.midiNote);
+        });
+
+    // Send any preview notes the caller has placed in this block
+    for (int n = 0; n < numPreviews; ++n)
+    {
+        const auto& previewNote = previews[n];
+        const int previewSample = std::clamp(previewNote.sampleOffset, 0, numSamples - 1);
+
+        sink.noteOn(previewSample, 1, previewNote.midiNote, 100);
+
+        // Schedule note-off for preview (100ms)
+        std::int64_t noteOffSample = totalSamplesProcessed + previewSample + static_cast<std::int64_t>(sampleRate * 0.1);
+        scheduleNoteOff({noteOffSample, previewNote.midiNote, 1}, previewSample, numSamples, sink);
+    }
+
+    const bool shouldPlay = transport.isPlaying;
+    const double currentBPM = transport.bpm;
+    const bool hostIsPlaying = transport.isHostPlaying;
+
+    // Host sync: while the host transport runs and reports a position, the rotation
+    // phase is derived from ppqPosition instead of being integrated block by block
+    const bool hostSynced = params.hostSync && hostIsPlaying && transport.hasPpqPosition
+                            && motorRunning && !isBeingScratched && std::abs(scratchVelocity) < 0.01f;
+
+    // Record player-style motor control: ramp up/down speed
+    // Motor only runs when BOTH DAW transport is playing AND motor toggle is ON
+    const float rampUpRate = 3.0f;    // Fast start (reaches full speed in ~0.33 seconds)
+    const float rampDownRate = 0.4f;  // Gradual stop (comes to halt in ~2.5 seconds)
+    const float rampStep = static_cast<float>(1.0 / sampleRate);  // Per-sample increment
+
+    // The free-running rotation replays the ramp sample by sample from here
+    const float blockStartSpeedMultiplier = currentSpeedMultiplier;
+    float speedMultiplierStep = 0.0f;
+
+    if (hostSynced)
+    {
+        // The host transport drives the platter directly - no spin-up lag
+        currentSpeedMultiplier = 1.0f;
+    }
+    else if (motorRunning && shouldPlay)  // BOTH conditions must be true
+    {
+        // Ramp up to full speed
+        speedMultiplierStep = rampUpRate * rampStep;
+        if (currentSpeedMultiplier < 1.0f)
+            currentSpeedMultiplier = std::min(1.0f, currentSpeedMultiplier + (rampUpRate * rampStep * static_cast<float>(numSamples)));
+    }
+    else
+    {
+        // Ramp down to stop (if either motor is OFF or DAW is stopped)
+        speedMultiplierStep = -rampDownRate * rampStep;
+        if (currentSpeedMultiplier > 0.0f)
+            currentSpeedMultiplier = std::max(0.0f, currentSpeedMultiplier - (rampDownRate * rampStep * static_cast<float>(numSamples)));
+    }
+
+    // Scratching physics: apply friction to scratch velocity (like motor slowdown)
+    const float blockStartScratchVelocity = scratchVelocity;
+    float scratchDecayStep = 0.0f;  // Fraction of the velocity lost per sample
+
+    if (!isBeingScratched && std::abs(scratchVelocity) > 0.01f)
+    {
+        // Apply friction to slow down the "thrown" turntable
+        // Use same decay rate as motor ramp-down for consistent feel
+        const float scratchDecayRate = 0.4f;  // Same as motor ramp down
+        const float decayStep = static_cast<float>(scratchDecayRate / sampleRate);
+        scratchDecayStep = decayStep;
+        float velocityReduction = decayStep * static_cast<float>(numSamples);
+
+        // Reduce velocity toward zero
+        if (scratchVelocity > 0.0f)
+            scratchVelocity = std::max(0.0f, scratchVelocity - (std::abs(scratchVelocity) * velocityReduction));
+        else
+            scratchVelocity = std::min(0.0f, scratchVelocity + (std::abs(scratchVelocity) * velocityReduction));
+
+        // Stop completely if velocity is very small
+        if (std::abs(scratchVelocity) < 0.1f)
+            scratchVelocity = 0.0f;
+    }
+
+    // Decides what dot i (at angle, normalised, on ringIndex) plays when it crosses the
+    // sensor: the probability roll, the velocity after variation and the swing delay.
+    // rotation is the turn the crossing belongs to (the whole turns in the sensor's
+    // absolute position), which with the dot's id keys the random decisions - so a
+    // crossing decides the same way whether it is found by a sweep or compiled ahead
+    // into the timeline, and editing other dots doesn't reshuffle this one's rolls.
+    auto decideCrossing = [&](size_t i, DotId dotId, float angle, int ringIndex, std::int64_t rotation, float swing)
+    {
+        TimelineEvent crossing;
+        crossing.dotIndex = static_cast<int>(i);
+        crossing.dotId = dotId;
+        crossing.ringIndex = ringIndex;
+
+        // Apply probability - check if this note should trigger
+        float probRoll = random.getFloat(rotation, dotId, CounterRandom::probabilityStream) * 100.0f;
+        crossing.passedProbability = probRoll <= probability;
+
+        if (!crossing.passedProbability)
+            return crossing;
+
+        // Apply swing timing based on beat position in rotation
+        // One full rotation = 8 beats, so calculate which beat this note falls on
+        if (swing > 0.0f)
+        {
+            // Calculate which 16th note subdivision this trigger falls on (0-31)
+            // One rotation = 8 beats = 32 sixteenth notes. The dot sits under the
+            // sensor when it fires, so its angle is the rotation at the crossing.
+            float rotationProgress = angle / 360.0f;  // 0.0 to 1.0
+            int sixteenthNote = static_cast<int>(rotationProgress * 32.0f) % 32;
+
+            // Apply swing to every other 16th note (odd numbered ones)
+            // This creates the classic "long-short" swing pattern
+            if (sixteenthNote % 2 == 1)
+            {
+                // Calculate tempo-relative swing delay
+                // At 100% swing: delay by full 16th note (dramatic swing)
+                // At 66% swing: classic jazz triplet feel
+                // At 50% swing: no swing (straight)
+                double secondsPerBeat = 60.0 / currentBPM;
+                double sixteenthNoteDuration = secondsPerBeat / 4.0;  // 16th note subdivision
+
+                // Swing percentage maps to delay amount:
+                // 50% = no delay (straight), 66% = triplet feel, 100% = full 16th delay
+                float swingRatio = (swing / 100.0f);  // 0.0 to 1.0
+                float delayRatio = (swingRatio - 0.5f) * 2.0f;  // -1.0 to 1.0, centered at 0.5 (50%)
+                delayRatio = std::clamp(delayRatio, 0.0f, 1.0f);  // Clamp to 0.0-1.0
+
+                double swingDelaySec = sixteenthNoteDuration * delayRatio;
+                crossing.swingOffset = static_cast<int>(swingDelaySec * sampleRate);
+            }
+        }
+
+        // Calculate velocity with variation
+        int finalVelocity = globalVelocity;
+        if (velocityVariation > 0.0f)
+        {
+            // Add random variation based on velocityVariation parameter
+            float variation = (random.getFloat(rotation, dotId, CounterRandom::velocityStream) * 2.0f - 1.0f)
+                              * (velocityVariation / 100.0f);
+            finalVelocity = static_cast<int>(static_cast<float>(globalVelocity) * (1.0f + variation * 0.5f));
+            finalVelocity = std::clamp(finalVelocity, 1, 127);
+        }
+
+        crossing.velocity = finalVelocity;
+        return crossing;
+    };
+
+    // Plays a decided crossing at triggerSample within this block. Only called with a
+    // non-null pattern.
+    auto playCrossing = [&](const TimelineEvent& crossing, int triggerSample)
+    {
+        const auto i = static_cast<size_t>(crossing.dotIndex);
+        pattern->triggeredThisRotation[i] = true; // Marked even if the probability roll skips it
+
+        if (!crossing.passedProbability)
+        {
+            // Track the dot pass but mark as not triggered for visual feedback
+            sink.dotPassed({
+                crossing.dotId,
+                totalSamplesProcessed + triggerSample,
+                0,              // velocity (not used when not triggered)
+                0.0f,           // gateTimeMs (not used when not triggered)
+                false,          // wasTriggered = false
+                swingBeatCounter
+            });
+            return; // Skip this note
+        }
+
+        swingBeatCounter++;
+
+        // Get MIDI note from ring index based on current scale
+        int midiNote = ScaleSystem::lookUpNote(noteTable, crossing.ringIndex);
+
+        PendingNoteOn note { totalSamplesProcessed + triggerSample + crossing.swingOffset,
+                             crossing.dotId, midiNote, crossing.velocity, gateTimeMs, swingBeatCounter };
+
+        // Swing can push the note past the end of this block - hold it until its block
+        // comes round so the delay is the same at every buffer size. Drop policy: if the
+        // queue is full the delayed note is skipped (its note-off was never scheduled).
+        if (triggerSample + crossing.swingOffset < numSamples)
+            sendNoteOn(note, triggerSample + crossing.swingOffset, numSamples, sink);
+        else
+            pendingNoteOnQueue.push(note);
+    };
+
+    // Sends dot i at triggerSample within this block, with swing interpolated to
+    // that sample (see decideCrossing for rotation)
+    auto fireDot = [&](size_t i, int triggerSample, std::int64_t rotation)
+    {
+        const float swing = swingAtBlockStart + (swingAtBlockEnd - swingAtBlockStart)
+                                                * (static_cast<float>(triggerSample) / static_cast<float>(numSamples));
+        const auto& dot = pattern->dots[i];
+        playCrossing(decideCrossing(i, dot.id, PatternSnapshot::normaliseAngle(dot.angle), dot.ringIndex, rotation, swing),
+                     triggerSample);
+    };
+
+    // A different snapshot needs its own timeline
+    if (pattern != timelinePattern)
+        timelineValid = false;
+
+    if (hostSynced)
+    {
+        // Phase-locked to the host: one rotation per 8 beats (scaled by speed), taken
+        // straight from ppqPosition so it can't drift - the angle is ppq * degreesPerBeat
+        // plus syncDegreesOffset. A speed change keeps the current angle and turns at the
+        // new rate from there (the offset absorbs the difference); a transport jump puts
+        // the platter back on the bar grid.
+        const float syncSpeed = params.speed;
+        const double degreesPerBeat = (isReversed ? -syncSpeed : syncSpeed) * 360.0 / 8.0;
+        const double ppqPerSample = currentBPM / (60.0 * sampleRate);
+
+        // Sweeps the ppq range [startPpq, endPpq) covering segmentLength samples from
+        // segmentStart. Each dot crossing has an exact ppq position, and it fires on the
+        // first sample at or after it - so consecutive blocks split the timeline without
+        // gaps or overlaps and every trigger lands on the same sample whatever the
+        // buffer size.
+        auto sweepSyncedSegment = [&](double startPpq, double endPpq, int segmentStart, int segmentLength, bool relocated)
+        {
+            const double startDegrees = startPpq * degreesPerBeat + syncDegreesOffset;
+            const double endDegrees = endPpq * degreesPerBeat + syncDegreesOffset;
+            rotationPhase = PatternSnapshot::degreesToPhase(endDegrees);
+            rotationCount = static_cast<std::int64_t>(std::floor(endDegrees / 360.0));
+
+            if (pattern == nullptr || segmentLength <= 0 || degreesPerBeat == 0.0 || ppqPerSample <= 0.0)
+                return;
+
+            // Keep the once-per-rotation flags coherent in case we drop back to free-running
+            if (relocated || std::floor(startDegrees / 360.0) != std::floor(endDegrees / 360.0))
+                pattern->clearTriggers();
+
+            // The angle index narrows the candidates (padded by a sample either side so a
+            // crossing just before the segment start is seen); the exact test is in ppq
+            const double direction = degreesPerBeat > 0.0 ? 1.0 : -1.0;
+            const double padding = std::abs(degreesPerBeat) * ppqPerSample + 0.01;
+            const double lowestDegrees = std::min(startDegrees, endDegrees) - padding;
+
+            pattern->forEachDotInArc(static_cast<float>(std::fmod(startDegrees - direction * padding, 360.0)),
+                                     static_cast<float>(endDegrees - startDegrees + direction * 2.0 * padding),
+                                     [&](size_t i)
+            {
+                const double dotAngle = pattern->dots[i].angle;
+                const double firstTurn = std::floor((lowestDegrees - dotAngle) / 360.0);
+
+                for (double turn = firstTurn; turn <= firstTurn + 1.0; turn += 1.0)
+                {
+                    const double crossingPpq = (dotAngle + 360.0 * turn - syncDegreesOffset) / degreesPerBeat;
+                    const double crossingSample = std::ceil((crossingPpq - startPpq) / ppqPerSample - 1.0e-6);
+
+                    if (crossingSample >= 0.0 && crossingSample < segmentLength)
+                        fireDot(i, segmentStart + static_cast<int>(crossingSample),
+                                static_cast<std::int64_t>(std::floor((dotAngle + 360.0 * turn) / 360.0)));
+                }
+            });
+        };
+
+        // Compiles every crossing of the given rotation into the snapshot's timeline, in
+        // the order they play, and puts the cursor on the first one at or after fromSample.
+        // Crossing samples are counted from the sync anchor with the same rounding as
+        // sweepSyncedSegment, so the timeline plays exactly what a sweep would.
+        auto compileRotation = [&](std::int64_t rotation, std::int64_t fromSample)
+        {
+            const auto& sorted = pattern->getSortedDots();
+            auto& events = pattern->timeline;
+            const size_t numActive = sorted.size();
+            const bool forward = degreesPerBeat > 0.0;
+
+            // The kernel maps degrees to ppq without the offset, so it moves the anchor instead
+            const double crossingAnchorPpq = syncAnchorPpq + syncDegreesOffset / degreesPerBeat;
+
+            // Where every dot crosses, in one vectorised pass over the sorted arrays
+            CrossingKernel::computeSyncCrossings(sorted.degrees.data(), sorted.turns.data(), numActive,
+                                                 static_cast<double>(rotation), degreesPerBeat, crossingAnchorPpq,
+                                                 ppqPerSample, pattern->crossingSamples.data(),
+                                                 pattern->crossingTurns.data());
+
+            for (size_t n = 0; n < numActive; ++n)
+            {
+                // Turning forwards the sensor meets the dots in angle order, in reverse the other way round
+                const size_t s = forward ? n : numActive - 1 - n;
+
+                events[n] = decideCrossing(sorted.indices[s], sorted.ids[s], sorted.angles[s], sorted.rings[s],
+                                           static_cast<std::int64_t>(pattern->crossingTurns[s]), swingAtBlockStart);
+                events[n].sample = static_cast<std::int64_t>(pattern->crossingSamples[s]);
+            }
+
+            // Already in order, up to the odd neighbours float rounding swaps (stable, in place)
+            for (size_t n = 1; n < numActive; ++n)
+                for (size_t m = n; m > 0 && events[m].sample < events[m - 1].sample; --m)
+                    std::swap(events[m], events[m - 1]);
+
+            timelineRotation = rotation;
+            timelineEndSample = static_cast<std::int64_t>(std::ceil((360.0 * static_cast<double>(forward ? rotation + 1 : rotation)
+                                                                     / degreesPerBeat - crossingAnchorPpq) / ppqPerSample - 1.0e-6));
+            timelineCursor = static_cast<size_t>(std::lower_bound(events.begin(), events.end(), fromSample,
+                                                                  [](const TimelineEvent& event, std::int64_t sample)
+                                                                  {
+                                                                      return event.sample < sample;
+                                                                  }) - events.begin());
+            timelinePattern = pattern;
+            timelineValid = true;
+        };
+
+        // Steady playback: plays the block [startPpq, endPpq) from the compiled timeline,
+        // moving on to the next rotation's timeline whenever the block reaches it. Costs
+        // a comparison per block plus the crossings actually played.
+        auto streamTimeline = [&](double startPpq, double endPpq, bool relocated)
+        {
+            const double startDegrees = startPpq * degreesPerBeat + syncDegreesOffset;
+            const double endDegrees = endPpq * degreesPerBeat + syncDegreesOffset;
+            rotationPhase = PatternSnapshot::degreesToPhase(endDegrees);
+            rotationCount = static_cast<std::int64_t>(std::floor(endDegrees / 360.0));
+
+            if (degreesPerBeat == 0.0 || ppqPerSample <= 0.0)
+                return;
+
+            // Keep the once-per-rotation flags coherent in case we drop back to free-running
+            if (relocated || std::floor(startDegrees / 360.0) != std::floor(endDegrees / 360.0))
+                pattern->clearTriggers();
+
+            const TimelineSettings settings { syncAnchorPpq, syncDegreesOffset, ppqPerSample, degreesPerBeat,
+                                              currentBPM, probability, globalVelocity, velocityVariation,
+                                              swingAtBlockStart };
+            const std::int64_t blockStart = syncSamplesSinceAnchor;
+            const std::int64_t blockEnd = blockStart + numSamples;
+
+            if (!timelineValid || !(settings == timelineSettings))
+            {
+                timelineSettings = settings;
+                compileRotation(static_cast<std::int64_t>(std::floor(startDegrees / 360.0)), blockStart);
+            }
+
+            const auto& events = pattern->timeline;
+            for (;;)
+            {
+                while (timelineCursor < events.size() && events[timelineCursor].sample < blockEnd)
+                {
+                    const auto& event = events[timelineCursor++];
+                    playCrossing(event, static_cast<int>(event.sample - blockStart));
+                }
+
+                if (timelineCursor < events.size() || timelineEndSample >= blockEnd)
+                    break;
+
+                compileRotation(timelineRotation + (degreesPerBeat > 0.0 ? 1 : -1), blockStart);
+            }
+        };
+
+        // A block that doesn't start where the last one ended (within a sample) is a
+        // relocation - transport jump or host-side loop wrap - and the phase is re-anchored
+        // there on the bar grid without sweeping the gap. Otherwise we continue from our
+        // own end position, so block boundaries match exactly; it is computed from an
+        // anchor rather than summed so rounding can't accumulate.
+        const double hostBlockStartPpq = transport.ppqPosition;
+        const double expectedStartPpq = syncAnchorPpq + syncPpqPerSample * static_cast<double>(syncSamplesSinceAnchor);
+        const bool relocated = !hostSyncActive
+                               || std::abs(hostBlockStartPpq - expectedStartPpq) > ppqPerSample;
+        const bool rateChanged = !relocated && degreesPerBeat != hostSyncDegreesPerBeat;
+
+        if (relocated)
+        {
+            // Notes delayed past a jump no longer belong to the timeline
+            pendingNoteOnQueue.clear();
+            syncDegreesOffset = 0.0;
+        }
+        else if (rateChanged)
+        {
+            // Speed or direction change: the platter carries on from the angle it has reached
+            syncDegreesOffset += expectedStartPpq * (hostSyncDegreesPerBeat - degreesPerBeat);
+        }
+
+        // Tempo and speed changes re-anchor too (the host reports one tempo per block)
+        if (relocated || rateChanged || ppqPerSample != syncPpqPerSample)
+        {
+            syncAnchorPpq = relocated ? hostBlockStartPpq : expectedStartPpq;
+            syncSamplesSinceAnchor = 0;
+            syncPpqPerSample = ppqPerSample;
+        }
+
+        const double blockStartPpq = syncAnchorPpq + ppqPerSample * static_cast<double>(syncSamplesSinceAnchor);
+        const double blockEndPpq = syncAnchorPpq + ppqPerSample * static_cast<double>(syncSamplesSinceAnchor + numSamples);
+
+        // Loop wraps inside this block: play up to the loop end, then continue from the loop start
+        if (transport.isLooping && transport.loopEndPpq > transport.loopStartPpq
+            && blockStartPpq < transport.loopEndPpq && blockEndPpq > transport.loopEndPpq && ppqPerSample > 0.0)
+        {
+            const int samplesToLoopEnd = std::clamp(
+                static_cast<int>(std::ceil((transport.loopEndPpq - blockStartPpq) / ppqPerSample)), 0, numSamples);
+            const int samplesAfterLoop = numSamples - samplesToLoopEnd;
+
+            // The anchor moves to the loop start, so the timeline is rebuilt next block
+            timelineValid = false;
+            sweepSyncedSegment(blockStartPpq, transport.loopEndPpq, 0, samplesToLoopEnd, relocated);
+
+            syncAnchorPpq = transport.loopStartPpq;
+            syncDegreesOffset = 0.0;
+            syncSamplesSinceAnchor = samplesAfterLoop;
+            sweepSyncedSegment(transport.loopStartPpq, transport.loopStartPpq + ppqPerSample * samplesAfterLoop,
+                               samplesToLoopEnd, samplesAfterLoop, true);
+        }
+        else if (timelineEnabled && pattern != nullptr && swingAtBlockStart == swingAtBlockEnd)
+        {
+            streamTimeline(blockStartPpq, blockEndPpq, relocated);
+            syncSamplesSinceAnchor += numSamples;
+        }
+        else
+        {
+            // Swing still gliding (or the timeline is off) - search this block directly
+            timelineValid = false;
+            sweepSyncedSegment(blockStartPpq, blockEndPpq, 0, numSamples, relocated);
+            syncSamplesSinceAnchor += numSamples;
+        }
+
+        hostSyncActive = true;
+        hostSyncDegreesPerBeat = degreesPerBeat;
+    }
+    else if (isBeingScratched)
+    {
+        // The editor is holding the platter and sets the angle directly
+        rotationPhase = PatternSnapshot::angleToPhase(currentRotation.load(std::memory_order_relaxed));
+    }
+    else
+    {
+        // Free-running: advance a fixed-point phase sample by sample, so crossings are
+        // found with exact integer arithmetic and nothing drifts. The step can change
+        // within the block (motor ramps, speed smoothing, scratch friction), in which
+        // case the sensor position is accumulated per sample and each crossing is
+        // looked up in it - timing is equally exact in both directions and across the seam.
+        const bool scratchMomentum = std::abs(scratchVelocity) > 0.01f;
+        const bool motorTurning = !scratchMomentum && (shouldPlay || blockStartSpeedMultiplier > 0.0f);
+        const bool forward = scratchMomentum ? blockStartScratchVelocity > 0.0f : !isReversed;
+        const double beatsPerSecond = currentBPM / 60.0;
+
+        const bool stepIsRamping = scratchMomentum ? scratchDecayStep > 0.0f
+                                                   : (motorTurning && (speedSmoothed.isSmoothing()
+                                                                       || blockStartSpeedMultiplier != currentSpeedMultiplier));
+
+        // Rotation covered during sample n of this block, in degrees (magnitude)
+        auto degreesDuringSample = [&](int sample) -> double
+        {
+            if (scratchMomentum)
+            {
+                // Apply scratch velocity, decaying by friction
+                const double remaining = std::max(0.0, 1.0 - static_cast<double>(scratchDecayStep) * (sample + 1));
+                return std::abs(blockStartScratchVelocity) * remaining / sampleRate;
+            }
+
+            if (!motorTurning)
+                return 0.0;
+
+            // Calculate rotation increment based on BPM and speed
+            // One full rotation per 2 bars (8 beats) at normal speed
+            const double speedMultiplier = std::clamp(static_cast<double>(blockStartSpeedMultiplier)
+                                                      + static_cast<double>(speedMultiplierStep) * (sample + 1), 0.0, 1.0);
+            const double effectiveSpeed = (stepIsRamping ? speedSmoothed.getNextValue() : speedSmoothed.getTargetValue())
+                                          * speedMultiplier;
+            const double rotationsPerSecond = (beatsPerSecond / 8.0) * effectiveSpeed;
+            return (rotationsPerSecond * 360.0) / sampleRate;
+        };
+
+        // Phase units (2^64 per turn); anything under half a turn per sample fits
+        auto toPhaseStep = [](double degrees)
+        {
+            return static_cast<std::uint64_t>(std::llround(std::ldexp(std::clamp(degrees / 360.0, 0.0, 0.49), 64)));
+        };
+
+        const auto maxPhase = std::numeric_limits<std::uint64_t>::max();
+        const int chunkCapacity = static_cast<int>(phaseOffsets.size()) - 1;
+        speedSmoothingConsumed = stepIsRamping && !scratchMomentum;
+
+        for (int chunkStart = 0; chunkStart < numSamples; )
+        {
+            // A constant step is handled in one go; ramps go through the offsets buffer
+            const int chunkLength = stepIsRamping ? std::min(chunkCapacity, numSamples - chunkStart)
+                                                  : numSamples - chunkStart;
+            if (chunkLength <= 0)
+                break;  // prepare hasn't run
+
+            std::uint64_t constantStep = 0;
+            std::uint64_t span = 0;
+
+            if (stepIsRamping)
+            {
+                // phaseOffsets[n + 1] = distance covered by the end of sample n (saturating)
+                phaseOffsets[0] = 0;
+                for (int n = 0; n < chunkLength; ++n)
+                {
+                    const auto step = toPhaseStep(degreesDuringSample(chunkStart + n));
+                    phaseOffsets[static_cast<size_t>(n) + 1] = phaseOffsets[static_cast<size_t>(n)] > maxPhase - step
+                                                                   ? maxPhase : phaseOffsets[static_cast<size_t>(n)] + step;
+                }
+                span = phaseOffsets[static_cast<size_t>(chunkLength)];
+            }
+            else
+            {
+                // Distance covered this block - a full turn or more is capped just short of one
+                constantStep = toPhaseStep(degreesDuringSample(0));
+                const auto chunkSamples = static_cast<std::uint64_t>(chunkLength);
+                span = constantStep > maxPhase / chunkSamples ? maxPhase : constantStep * chunkSamples;
+            }
+
+            const std::uint64_t startPhase = rotationPhase;
+            const std::int64_t startRotation = rotationCount;
+            rotationPhase = forward ? startPhase + span : startPhase - span;
+
+            // Crossed the seam (either direction)?
+            const bool completedRotation = forward ? rotationPhase < startPhase : span > startPhase;
+            if (completedRotation)
+                rotationCount += forward ? 1 : -1;
+
+            if (pattern != nullptr && span > 0)
+            {
+                // Trigger tracking resets where the sensor crosses the seam - after the dots
+                // before it in this chunk have fired, so their flags don't carry into the
+                // next turn
+                bool seamCleared = !completedRotation;
+
+                // Trigger point: a dot is under the sensor (visual angle 0° = top) when the
+                // rotation equals its angle, and it fires on the sample during which the
+                // sensor reaches it. The starting position belongs to the previous block,
+                // unless the platter was at rest there.
+                const bool includeStart = !rotationWasMoving;
+                const std::uint64_t rangeStart = includeStart ? startPhase : (forward ? startPhase + 1 : startPhase - 1);
+                const std::uint64_t rangeLength = includeStart && span < maxPhase ? span + 1 : span;
+
+                pattern->forEachDotInPhaseRange(rangeStart, rangeLength, forward, [&](size_t i, std::uint64_t offset)
+                {
+                    const std::uint64_t distance = includeStart ? offset : offset + 1;
+
+                    // Dots past the seam belong to the next (or, in reverse, previous) turn
+                    const std::uint64_t dotPhase = forward ? startPhase + distance : startPhase - distance;
+                    const std::int64_t rotation = startRotation + (forward ? (dotPhase < startPhase ? 1 : 0)
+                                                                           : (dotPhase > startPhase ? -1 : 0));
+
+                    if (rotation != startRotation && !seamCleared)
+                    {
+                        pattern->clearTriggers();
+                        seamCleared = true;
+                    }
+
+                    // Only trigger each dot once per rotation
+                    if (pattern->triggeredThisRotation[i])
+                        return;
+
+                    std::uint64_t crossingSample = 0;
+
+                    if (stepIsRamping)
+                    {
+                        // First sample whose end position reaches the dot
+                        const auto* ends = phaseOffsets.data() + 1;
+                        crossingSample = static_cast<std::uint64_t>(std::lower_bound(ends, ends + chunkLength, distance) - ends);
+                    }
+                    else if (distance > 0)
+                    {
+                        crossingSample = (distance - 1) / constantStep;  // ceil(distance / step) - 1
+                    }
+
+                    auto sampleInChunk = std::min(crossingSample, static_cast<std::uint64_t>(chunkLength - 1));
+                    fireDot(i, chunkStart + static_cast<int>(sampleInChunk), rotation);
+                });
+
+                if (!seamCleared)
+                    pattern->clearTriggers();
+            }
+
+            rotationWasMoving = span > 0;
+
+            chunkStart += chunkLength;
+        }
+    }
+
+    if (hostSynced || isBeingScratched)
+        rotationWasMoving = false;  // Free-running resumes from a position no sweep has covered
+
+    if (!speedSmoothingConsumed)
+        speedSmoothed.skip(numSamples);
+
+    if (!hostSynced)
+    {
+        hostSyncActive = false;
+        timelineValid = false;
+    }
+
+    // Send delayed note-ons that fall in this block, in time order. They were scheduled
+    // against the transport, so a host stop or relocation cancels them instead.
+    if (wasHostPlaying && !hostIsPlaying)
+        pendingNoteOnQueue.clear();
+    wasHostPlaying = hostIsPlaying;
+
+    pendingNoteOnQueue.popEventsBefore(totalSamplesProcessed + numSamples,
+        [&](const PendingNoteOn& note)
+        {
+            auto noteOnInBuffer = std::max(std::int64_t(0), note.samplePosition - totalSamplesProcessed);
+            sendNoteOn(note, static_cast<int>(noteOnInBuffer), numSamples, sink);
+        });
+
+    // Publish the angle for the editor
+    if (!isBeingScratched)
+        currentRotation.store(PatternSnapshot::phaseToAngle(rotationPhase), std::memory_order_relaxed);
+
+    // Increment total samples processed for accurate note-off timing across buffers
+    totalSamplesProcessed += numSamples;
+    publishedSamplePosition.store(totalSamplesProcessed, std::memory_order_relaxed);
+}
+
+void SkaldEngine::sendNoteOn(const PendingNoteOn& note, int sampleInBlock,
+                             int numSamples, EngineEventSink& sink)
+{
+    // All notes go to MIDI channel 1
+    sink.noteOn(sampleInBlock, 1, note.midiNote, note.velocity);
+
+    // Schedule note-off based on gate time (will be sent in future buffer)
+    std::int64_t absoluteNoteOffSample = totalSamplesProcessed + sampleInBlock +
+        static_cast<std::int64_t>(sampleRate * (note.gateTimeMs / 1000.0));
+    scheduleNoteOff({absoluteNoteOffSample, note.midiNote, 1}, sampleInBlock, numSamples, sink);
+
+    // Track this dot for visual feedback with full parameter info
+    sink.dotPassed({
+        note.dotId,
+        totalSamplesProcessed + sampleInBlock,
+        note.velocity,      // Actual velocity after variation
+        note.gateTimeMs,    // Gate time parameter
+        true,               // wasTriggered = true
+        note.beatCount      // Beat counter for swing visualization
+    });
+}
+
+void SkaldEngine::scheduleNoteOff(const ScheduledNoteOff& noteOff, int sampleInBlock,
+                                  int numSamples, EngineEventSink& sink)
+{
+    // Short gates can end inside the current buffer - send those straight away
+    auto noteOffInBuffer = noteOff.samplePosition - totalSamplesProcessed;
+    if (noteOffInBuffer < numSamples)
+    {
+        sink.noteOff(static_cast<int>(std::max(std::int64_t(sampleInBlock), noteOffInBuffer)),
+                     noteOff.channel, noteOff.midiNote);
+        return;
+    }
+
+    // Overflow policy: cut the note that would end soonest to make room
+    if (noteOffQueue.isFull() && !noteOffQueue.isEmpty())
+    {
+        auto earliest = noteOffQueue.pop();
+        sink.noteOff(sampleInBlock, earliest.channel, earliest.midiNote);
+    }
+
+    // Only fails if prepare was never called - end the note now rather than leave it hanging
+    if (!noteOffQueue.push(noteOff))
+        sink.noteOff(sampleInBlock, noteOff.channel, noteOff.midiNote);
+}
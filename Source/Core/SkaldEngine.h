@@ -0,0 +1,234 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "CounterRandom.h"
+#include "LinearSmoother.h"
+#include "PatternSnapshot.h"
+#include "ScaleSystem.h"
+#include "ScheduledEventQueue.h"
+
+//==============================================================================
+// Performance parameters, sampled once per block by whoever drives the engine
+struct EngineParameters
+{
+    float speed = 1.0f;               // Rotation speed multiplier
+    int velocity = 100;               // MIDI velocity (1-127)
+    float gateTimeMs = 100.0f;        // Note duration in milliseconds
+    bool reverse = false;             // Reverse rotation direction
+    bool motorRunning = true;         // Motor on/off state
+    float probability = 100.0f;       // Probability of note trigger (0-100%)
+    float velocityVariation = 0.0f;   // Velocity randomization amount (0-100%)
+    float swing = 0.0f;               // Swing amount (0-100%)
+    bool hostSync = true;             // Follow the transport's ppqPosition when available
+};
+
+// Where the transport is at the start of a block
+struct TransportState
+{
+    double bpm = 120.0;
+    bool isPlaying = false;           // Platter should turn (host or standalone transport running)
+    bool isHostPlaying = false;       // An external transport is running (enables host sync)
+    bool hasPpqPosition = false;      // ppqPosition is valid
+    double ppqPosition = 0.0;         // Musical position in quarter notes
+    bool isLooping = false;
+    double loopStartPpq = 0.0;
+    double loopEndPpq = 0.0;
+};
+
+// One dot passing the sensor, for visual feedback
+struct TriggerEvent
+{
+    DotId dotId;                  // Stable id of the dot (see PatternDot)
+    std::int64_t samplePosition;  // Audio sample clock when the dot passed the sensor
+    int velocity;           // Actual triggered velocity (after variation)
+    float gateTimeMs;       // Gate time for this trigger
+    bool wasTriggered;      // True if probability allowed trigger
+    int beatCount;          // Beat counter state (for swing visualization)
+};
+
+// A note requested from outside the pattern (UI preview), already placed in the block
+struct PreviewNote
+{
+    int midiNote;
+    int sampleOffset;
+};
+
+// Receives everything the engine produces during process(). Sample positions are
+// offsets into the current block; calls arrive on the audio thread.
+class EngineEventSink
+{
+public:
+    virtual ~EngineEventSink() = default;
+
+    virtual void noteOn(int sampleInBlock, int channel, int midiNote, int velocity) = 0;
+    virtual void noteOff(int sampleInBlock, int channel, int midiNote) = 0;
+    virtual void dotPassed(const TriggerEvent& event) = 0;
+};
+
+//==============================================================================
+// The sequencer itself: rotation, sensor crossings, scale mapping and note
+// scheduling, with no dependency on JUCE or any GUI. process() never locks or
+// allocates once prepare() has run; real-time callers check that by opening
+// SKALD_REALTIME_SCOPE around it, offline ones (whose sinks may allocate) don't.
+class SkaldEngine
+{
+public:
+    SkaldEngine() = default;
+
+    // Allocates everything the audio thread needs (keeps any notes still sounding)
+    void prepare(double newSampleRate, int maxBlockSize, const EngineParameters& initialParameters);
+
+    // Advances the turntable by numSamples, reporting notes and dot passes to sink. An
+    // empty block does nothing at all, so callers should keep its previews for the next.
+    void process(int numSamples, const TransportState& transport, const EngineParameters& params,
+                 EngineEventSink& sink, const PreviewNote* previews = nullptr, int numPreviews = 0);
+
+    // The most note-offs held for later blocks - all of them can fall due in one block
+    static constexpr size_t maxScheduledNoteOffs = 4096;
+
+    // Message thread: hand a new pattern to the audio thread, and free the ones it has let go of
+    void publishPattern(std::vector<PatternDot> dots);
+    void collectGarbage() { patternExchange.collectGarbage(); }
+
+    // Scale and key (message thread)
+    ScaleSystem& getScaleSystem() { return scaleSystem; }
+    const ScaleSystem& getScaleSystem() const { return scaleSystem; }
+
+    // Current rotation angle (0-360), for display
+    float getCurrentRotation() const { return currentRotation.load(std::memory_order_relaxed); }
+    void setRotationDirect(float angle) { currentRotation.store(angle, std::memory_order_relaxed); }
+
+    // Scratching control (manual turntable manipulation)
+    void setScratchVelocity(float velocity) { scratchVelocity = velocity; }
+    float getScratchVelocity() const { return scratchVelocity; }
+    void setBeingScratched(bool scratching) { isBeingScratched = scratching; }
+    float getCurrentSpeedMultiplier() const { return currentSpeedMultiplier; }
+    void setCurrentSpeedMultiplier(float mult) { currentSpeedMultiplier = mult; }
+
+    // Host-synced playback streams a precompiled timeline of each rotation instead of
+    // searching for crossings every block. On by default; off forces the per-block
+    // sweep (for comparison - both play the same notes).
+    void setTimelineEnabled(bool shouldBeEnabled) { timelineEnabled = shouldBeEnabled; }
+
+    // Reseeds probability and velocity variation, for reproducible renders
+    void setRandomSeed(std::int64_t seed) { random.setSeed(seed); }
+
+    // Audio sample clock at the end of the last processed block (for ageing telemetry)
+    std::int64_t getSamplePosition() const { return publishedSamplePosition.load(std::memory_order_relaxed); }
+    double getSampleRate() const { return sampleRate; }
+
+private:
+    // Pending note-off for a sounding MIDI note
+    struct ScheduledNoteOff
+    {
+        std::int64_t samplePosition;  // Absolute sample position when note should turn off
+        int midiNote;
+        int channel;
+    };
+
+    // Note-offs still to be sent, earliest first. Preallocated in prepare so the
+    // audio thread never allocates; when it is full the note-off due soonest is
+    // sent early to make room (so no note is ever left hanging).
+    ScheduledEventQueue<ScheduledNoteOff> noteOffQueue;
+    void scheduleNoteOff(const ScheduledNoteOff& noteOff, int sampleInBlock,
+                         int numSamples, EngineEventSink& sink);
+
+    // Note-on delayed into a later block (e.g. by swing). Its note-off is only
+    // scheduled once the note-on has actually been sent.
+    struct PendingNoteOn
+    {
+        std::int64_t samplePosition;  // Absolute sample position of the note-on
+        DotId dotId;
+        int midiNote;
+        int velocity;
+        float gateTimeMs;
+        int beatCount;
+    };
+
+    static constexpr size_t maxPendingNoteOns = 1024;
+    ScheduledEventQueue<PendingNoteOn> pendingNoteOnQueue;
+    bool wasHostPlaying = false;
+    void sendNoteOn(const PendingNoteOn& note, int sampleInBlock,
+                    int numSamples, EngineEventSink& sink);
+
+    std::int64_t totalSamplesProcessed = 0;  // Track absolute sample position
+    std::atomic<std::int64_t> publishedSamplePosition { 0 };
+    double sampleRate = 44100.0;
+
+    // Immutable snapshots of the pattern handed to the audio thread
+    PatternSnapshotExchange patternExchange;
+
+    ScaleSystem scaleSystem;
+
+    std::atomic<float> currentRotation { 0.0f };  // Current rotation angle (0-360), for display
+    std::uint64_t rotationPhase = 0;              // Audio thread's rotation (2^64 = one turn)
+    std::int64_t rotationCount = 0;               // Whole turns behind rotationPhase (negative in reverse)
+    bool rotationWasMoving = false;               // Whether the last free-running block moved
+    std::vector<std::uint64_t> phaseOffsets;      // Per-sample distance travelled, sized in prepare
+
+    // Speed and swing glide to new values sample-by-sample instead of stepping
+    // once per block, so automation doesn't produce timing jumps
+    LinearSmoother speedSmoothed { 1.0f };
+    LinearSmoother swingSmoothed { 0.0f };
+
+    // Host sync state (audio thread): where the previous synced block ended, so
+    // transport jumps and loop wraps can be told apart from normal playback
+    bool hostSyncActive = false;
+    double hostSyncDegreesPerBeat = 0.0;
+    double syncAnchorPpq = 0.0;
+    double syncDegreesOffset = 0.0;   // Angle at ppq 0 beyond ppq * degreesPerBeat (see process)
+    double syncPpqPerSample = 0.0;
+    std::int64_t syncSamplesSinceAnchor = 0;
+
+    // Precompiled sync timeline (audio thread). While the tempo, speed, swing, note
+    // parameters and pattern hold steady, the crossings of the current rotation are
+    // compiled into the snapshot's timeline - sample, probability roll, velocity and
+    // swing delay - and each block only streams a cursor through it. Anything that
+    // changes the settings below (or the pattern, or a loop wrap) recompiles it, and
+    // so does reaching the next rotation.
+    struct TimelineSettings
+    {
+        double anchorPpq = 0.0;
+        double degreesOffset = 0.0;
+        double ppqPerSample = 0.0;
+        double degreesPerBeat = 0.0;
+        double bpm = 0.0;
+        float probability = 0.0f;
+        int velocity = 0;
+        float velocityVariation = 0.0f;
+        float swing = 0.0f;
+
+        bool operator== (const TimelineSettings& other) const noexcept
+        {
+            return anchorPpq == other.anchorPpq && degreesOffset == other.degreesOffset
+                && ppqPerSample == other.ppqPerSample
+                && degreesPerBeat == other.degreesPerBeat && bpm == other.bpm
+                && probability == other.probability && velocity == other.velocity
+                && velocityVariation == other.velocityVariation && swing == other.swing;
+        }
+    };
+
+    bool timelineEnabled = true;
+    bool timelineValid = false;
+    TimelineSettings timelineSettings;
+    PatternSnapshot* timelinePattern = nullptr;  // Snapshot the timeline was compiled into
+    std::int64_t timelineRotation = 0;           // Turn the compiled crossings belong to
+    std::int64_t timelineEndSample = 0;          // First sample of the next turn, from the anchor
+    size_t timelineCursor = 0;                   // Next event to play
+
+    // Motor control (record player style)
+    float currentSpeedMultiplier = 1.0f; // Current speed (ramps up/down like record player)
+
+    // Scratching/manual control
+    float scratchVelocity = 0.0f;       // Angular velocity from scratching (degrees per second)
+    bool isBeingScratched = false;      // True when user is actively scratching
+
+    // Probability and velocity variation, keyed by rotation and dot so every
+    // decision is reproducible (see CounterRandom)
+    CounterRandom random;
+
+    // Track swing state (which beat we're on for swing timing)
+    int swingBeatCounter = 0;
+};
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//==============================================================================
+// Stores values densely and hands out stable handles to them.
+//
+// An Id packs a slot index (low 20 bits) with that slot's generation (high 12
+// bits). Removing a value moves the last one into its place, so insert, remove
+// and lookup are all O(1) and iteration runs over one contiguous array - but the
+// iteration order changes on removal, so hold on to Ids, never positions. A removed
+// value's slot moves to the next generation, which makes every Id still pointing at
+// it stale instead of silently referring to whatever is stored there next (until
+// the same slot has been reused 4096 times).
+//
+// Not thread-safe; for use on the message thread.
+template <typename ValueType>
+class SlotMap
+{
+public:
+    using Id = std::uint32_t;
+    static constexpr Id invalidId = ~Id(0);
+    static constexpr int slotBits = 20;
+    static constexpr std::uint32_t slotMask = (1u << slotBits) - 1;
+
+    static constexpr std::uint32_t getSlot(Id id) noexcept { return id & slotMask; }
+
+    // Returns invalidId only if every slot is taken
+    Id insert(ValueType value)
+    {
+        std::uint32_t slot = 0;
+        if (!freeSlots.empty())
+        {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        else
+        {
+            if (slots.size() >= slotMask)
+                return invalidId;
+
+            slot = static_cast<std::uint32_t>(slots.size());
+            slots.push_back({ freeMarker, 0 });
+        }
+
+        const Id id = makeId(slot, slots[slot].generation);
+        slots[slot].denseIndex = static_cast<std::uint32_t>(values.size());
+        values.push_back(std::move(value));
+        denseIds.push_back(id);
+        return id;
+    }
+
+    // Returns false if id was already removed (or never existed)
+    bool remove(Id id)
+    {
+        if (!contains(id))
+            return false;
+
+        const auto slot = getSlot(id);
+        const auto denseIndex = slots[slot].denseIndex;
+        const auto lastIndex = static_cast<std::uint32_t>(values.size() - 1);
+
+        // Fill the gap with the last value
+        if (denseIndex != lastIndex)
+        {
+            values[denseIndex] = std::move(values[lastIndex]);
+            denseIds[denseIndex] = denseIds[lastIndex];
+            slots[getSlot(denseIds[denseIndex])].denseIndex = denseIndex;
+        }
+
+        values.pop_back();
+        denseIds.pop_back();
+        release(slot);
+        return true;
+    }
+
+    // Removes everything; every Id handed out so far becomes stale
+    void clear()
+    {
+        for (auto id : denseIds)
+            release(getSlot(id));
+
+        values.clear();
+        denseIds.clear();
+    }
+
+    bool contains(Id id) const noexcept
+    {
+        const auto slot = getSlot(id);
+        return id != invalidId && slot < slots.size() && slots[slot].denseIndex != freeMarker
+               && makeId(slot, slots[slot].generation) == id;
+    }
+
+    // nullptr if id is stale
+    ValueType* find(Id id) noexcept             { return contains(id) ? &values[slots[getSlot(id)].denseIndex] : nullptr; }
+    const ValueType* find(Id id) const noexcept { return contains(id) ? &values[slots[getSlot(id)].denseIndex] : nullptr; }
+
+    // Dense access, in storage order
+    size_t size() const noexcept                        { return values.size(); }
+    bool isEmpty() const noexcept                       { return values.empty(); }
+    Id getId(size_t denseIndex) const noexcept          { return denseIds[denseIndex]; }
+    ValueType& operator[](size_t denseIndex) noexcept   { return values[denseIndex]; }
+    const ValueType& operator[](size_t denseIndex) const noexcept { return values[denseIndex]; }
+
+    auto begin() noexcept       { return values.begin(); }
+    auto end() noexcept         { return values.end(); }
+    auto begin() const noexcept { return values.begin(); }
+    auto end() const noexcept   { return values.end(); }
+
+private:
+    static constexpr std::uint32_t freeMarker = ~std::uint32_t(0);
+    static constexpr std::uint32_t generationMask = (1u << (32 - slotBits)) - 1;
+
+    struct Slot
+    {
+        std::uint32_t denseIndex;   // Where the value lives, or freeMarker
+        std::uint32_t generation;
+    };
+
+    static constexpr Id makeId(std::uint32_t slot, std::uint32_t generation) noexcept
+    {
+        return slot | (generation << slotBits);
+    }
+
+    void release(std::uint32_t slot)
+    {
+        // Skip the generation that would make the last slot's Id equal invalidId
+        auto& entry = slots[slot];
+        entry.generation = (entry.generation + 1) & generationMask;
+        if (makeId(slot, entry.generation) == invalidId)
+            entry.generation = 0;
+
+        entry.denseIndex = freeMarker;
+        freeSlots.push_back(slot);
+    }
+
+    std::vector<ValueType> values;
+    std::vector<Id> denseIds;        // Id of each value, in the same order
+    std::vector<Slot> slots;
+    std::vector<std::uint32_t> freeSlots;
+};
@@ -0,0 +1,153 @@
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+#include <deque>
+
+//==============================================================================
+struct WorkStealingPool::WorkerQueue
+{
+    std::mutex lock;
+    std::deque<size_t> jobs;
+
+    // Owner end
+    bool popBack(size_t& jobIndex)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (jobs.empty())
+            return false;
+
+        jobIndex = jobs.back();
+        jobs.pop_back();
+        return true;
+    }
+
+    // Thief end
+    bool popFront(size_t& jobIndex)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (jobs.empty())
+            return false;
+
+        jobIndex = jobs.front();
+        jobs.pop_front();
+        return true;
+    }
+};
+
+//==============================================================================
+WorkStealingPool::WorkStealingPool(int requestedThreads)
+    : numThreads(requestedThreads > 0 ? requestedThreads : std::max(1, static_cast<int>(std::thread::hardware_concurrency())))
+{
+    for (int w = 0; w < numThreads; ++w)
+        queues.push_back(std::make_unique<WorkerQueue>());
+
+    // The thread calling run() is worker 0
+    for (int w = 1; w < numThreads; ++w)
+        threads.emplace_back(&WorkStealingPool::workerThread, this, static_cast<size_t>(w));
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        shuttingDown = true;
+    }
+
+    runStarted.notify_all();
+
+    for (auto& thread : threads)
+        thread.join();
+}
+
+void WorkStealingPool::run(size_t numJobs, const std::function<void(size_t jobIndex)>& job)
+{
+    if (numJobs == 0)
+        return;
+
+    const size_t numWorkers = std::min(static_cast<size_t>(numThreads), numJobs);
+
+    // Deal the jobs out in contiguous runs, one per worker. The other workers are all
+    // asleep until the run starts, so the queues can be filled without contention.
+    for (size_t w = 0; w < numWorkers; ++w)
+        for (size_t i = w * numJobs / numWorkers; i < (w + 1) * numJobs / numWorkers; ++i)
+            queues[w]->jobs.push_back(i);
+
+    firstError = nullptr;
+
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        currentJob = &job;
+        numWorkersInRun = numWorkers;
+        numThreadsBusy = threads.size();
+        ++runNumber;
+    }
+
+    runStarted.notify_all();
+
+    // The calling thread works too, then waits for the others to check in
+    workThrough(0);
+
+    {
+        std::unique_lock<std::mutex> guard(stateLock);
+        runFinished.wait(guard, [this] { return numThreadsBusy == 0; });
+        currentJob = nullptr;
+    }
+
+    if (firstError != nullptr)
+        std::rethrow_exception(firstError);
+}
+
+void WorkStealingPool::workerThread(size_t self)
+{
+    std::uint64_t lastRun = 0;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> guard(stateLock);
+            runStarted.wait(guard, [&] { return shuttingDown || runNumber != lastRun; });
+
+            if (shuttingDown)
+                return;
+
+            lastRun = runNumber;
+        }
+
+        if (self < numWorkersInRun)
+            workThrough(self);
+
+        std::lock_guard<std::mutex> guard(stateLock);
+        if (--numThreadsBusy == 0)
+            runFinished.notify_one();
+    }
+}
+
+void WorkStealingPool::workThrough(size_t self)
+{
+    const size_t numWorkers = numWorkersInRun;
+    size_t jobIndex = 0;
+
+    for (;;)
+    {
+        bool found = queues[self]->popBack(jobIndex);
+
+        // Nothing left of our own - steal the oldest job of the next busy worker.
+        // No jobs are added while running, so one empty sweep means we're done.
+        for (size_t offset = 1; !found && offset < numWorkers; ++offset)
+            found = queues[(self + offset) % numWorkers]->popFront(jobIndex);
+
+        if (!found)
+            return;
+
+        try
+        {
+            (*currentJob)(jobIndex);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> guard(errorLock);
+            if (firstError == nullptr)
+                firstError = std::current_exception();
+        }
+    }
+}
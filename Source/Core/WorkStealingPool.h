@@ -0,0 +1,64 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//==============================================================================
+// Runs batches of independent jobs across worker threads. Each worker starts with
+// an even share of the job indices in its own deque and works through it from the
+// back; once it runs dry it steals from the front of the other workers' deques, so
+// uneven jobs (a 10,000-dot pattern next to a 4-dot one) still keep every core busy.
+//
+// The worker threads are started with the pool and sleep between runs, so a run
+// costs a wake-up rather than a thread spawn per worker. The thread that calls run()
+// works as worker 0.
+//
+// Jobs must not depend on each other or on the order they run in. One run at a
+// time; not for use on the audio thread.
+class WorkStealingPool
+{
+public:
+    // numThreads <= 0 uses one thread per hardware core
+    explicit WorkStealingPool(int numThreads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    int getNumThreads() const { return numThreads; }
+
+    // Calls job(index) once for every index in [0, numJobs) and returns when all of
+    // them have finished. If a job throws, the first exception is rethrown here
+    // (after the remaining jobs have run).
+    void run(size_t numJobs, const std::function<void(size_t jobIndex)>& job);
+
+private:
+    struct WorkerQueue;
+
+    void workerThread(size_t self);
+    void workThrough(size_t self);
+
+    int numThreads;
+    std::vector<std::unique_ptr<WorkerQueue>> queues;  // One per worker, reused by every run
+    std::vector<std::thread> threads;                  // Workers 1 and up
+
+    // The current run, handed to the workers under stateLock
+    std::mutex stateLock;
+    std::condition_variable runStarted;
+    std::condition_variable runFinished;
+    const std::function<void(size_t)>* currentJob = nullptr;
+    size_t numWorkersInRun = 0;     // Workers past this have no share of the current run
+    std::uint64_t runNumber = 0;
+    size_t numThreadsBusy = 0;
+    bool shuttingDown = false;
+
+    std::mutex errorLock;
+    std::exception_ptr firstError;
+};
@@ -65,6 +65,67 @@ void MusicToggle::paint(juce::Graphics& g)
                 0, sourceY, frameWidth, frameHeight);    // source
 }
 
+//==============================================================================
+// GlowAtlas implementation
+void GlowAtlas::prepare(float scale)
+{
+    if (scale == preparedScale)
+        return;
+
+    // Each glow as concentric rings from the faint edge inwards: radius as a fraction
+    // of the outer one, and alpha at full strength
+    struct Ring { float radius; float alpha; };
+    auto rings = [](int type, int ring) -> Ring
+    {
+        switch (type)
+        {
+            case armGlow:   return { (6.0f + ring * 3.0f) / 24.0f, 0.35f - ring * 0.045f };
+            case dotGlow:   return { (1.5f + ring * 0.4f) / 3.9f, 0.25f * (1.0f - (ring / 7.0f)) };
+            default:        return { (1.5f + ring * 0.4f) / 2.3f, 0.08f + ring * 0.02f };
+        }
+    };
+
+    for (int type = 0; type < numGlowTypes; ++type)
+    {
+        const int numRings = type == tracerGlow ? 3 : 7;
+
+        for (int size = 0; size < numSizes; ++size)
+        {
+            const int diameter = juce::jmax(1, juce::roundToInt((16 << size) * scale));
+            const float half = diameter / 2.0f;
+
+            juce::Image mask(juce::Image::SingleChannel, diameter, diameter, true);
+            juce::Graphics g(mask);
+            for (int ring = numRings - 1; ring >= 0; --ring)
+            {
+                const auto r = rings(type, ring);
+                g.setColour(juce::Colours::white.withAlpha(r.alpha));
+                g.fillEllipse(half - r.radius * half, half - r.radius * half, r.radius * diameter, r.radius * diameter);
+            }
+
+            masks[static_cast<size_t>(type)][static_cast<size_t>(size)] = mask;
+        }
+    }
+
+    preparedScale = scale;
+}
+
+void GlowAtlas::draw(juce::Graphics& g, GlowType type, juce::Point<float> centre, float radius, juce::Colour colour) const
+{
+    if (radius <= 0.0f || preparedScale <= 0.0f)
+        return;
+
+    // The smallest mask that is at least as big as the glow, so it is only ever scaled down
+    size_t size = 0;
+    while (size + 1 < numSizes && (16 << size) < 2.0f * radius)
+        ++size;
+
+    g.setColour(colour);
+    g.drawImage(masks[static_cast<size_t>(type)][size],
+                juce::Rectangle<float>(centre.x - radius, centre.y - radius, radius * 2.0f, radius * 2.0f),
+                juce::RectanglePlacement::stretchToFit, true);
+}
+
 //==============================================================================
 // HardwareButtonLookAndFeel implementations
 void HardwareButtonLookAndFeel::drawButtonBackground(juce::Graphics& g, juce::Button& button,
@@ -281,11 +342,7 @@ SkaldEditor::SkaldEditor (SkaldProcessor& p)
     bpmLabel.setFont(juce::FontOptions("Arial", 11.0f, juce::Font::bold));
 
     // Velocity knob
-    velocityKnob.setRange(1.0, 127.0, 1.0);
-    velocityKnob.setValue(100.0);
-    velocityKnob.onValueChange = [this]() {
-        audioProcessor.setGlobalVelocity(static_cast<int>(velocityKnob.getValue()));
-    };
+    velocityAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParamIDs::velocity, velocityKnob);
     velocityKnob.setSpriteImage(knobSprite, 101);
     addAndMakeVisible(velocityKnob);
 
@@ -296,12 +353,8 @@ SkaldEditor::SkaldEditor (SkaldProcessor& p)
     addAndMakeVisible(velocityLabel);
 
     // Gate time knob
-    gateTimeKnob.setRange(10.0, 2000.0, 1.0);
-    gateTimeKnob.setValue(100.0);
-    gateTimeKnob.setSkewFactorFromMidPoint(250.0); // Make lower values easier to adjust
-    gateTimeKnob.onValueChange = [this]() {
-        audioProcessor.setGateTime(static_cast<float>(gateTimeKnob.getValue()));
-    };
+    // (the parameter's range is skewed around 250ms to make lower values easier to adjust)
+    gateTimeAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParamIDs::gateTime, gateTimeKnob);
     gateTimeKnob.setSpriteImage(knobSprite, 101);
     addAndMakeVisible(gateTimeKnob);
 
@@ -312,9 +365,7 @@ SkaldEditor::SkaldEditor (SkaldProcessor& p)
     addAndMakeVisible(gateTimeLabel);
 
     // Reverse toggle
-    reverseToggle.onClick = [this]() {
-        audioProcessor.setReverse(reverseToggle.getToggleState());
-    };
+    reverseAttachment = std::make_unique<ButtonAttachment>(audioProcessor.parameters, ParamIDs::reverse, reverseToggle);
     reverseToggle.setSpriteImage(toggleSprite);
     addAndMakeVisible(reverseToggle);
 
@@ -325,10 +376,7 @@ SkaldEditor::SkaldEditor (SkaldProcessor& p)
     addAndMakeVisible(reverseLabel);
 
     // Start/Stop toggle (record player style)
-    startStopToggle.onClick = [this]() {
-        audioProcessor.setMotorRunning(startStopToggle.getToggleState());
-    };
-    startStopToggle.setToggleState(true, juce::dontSendNotification);  // Default to running
+    startStopAttachment = std::make_unique<ButtonAttachment>(audioProcessor.parameters, ParamIDs::motor, startStopToggle);
     startStopToggle.setSpriteImage(toggleSprite);
     addAndMakeVisible(startStopToggle);
 
@@ -339,11 +387,7 @@ SkaldEditor::SkaldEditor (SkaldProcessor& p)
     addAndMakeVisible(startStopLabel);
 
     // Probability knob
-    probabilityKnob.setRange(0.0, 100.0, 1.0);
-    probabilityKnob.setValue(100.0);
-    probabilityKnob.onValueChange = [this]() {
-        audioProcessor.setProbability(static_cast<float>(probabilityKnob.getValue()));
-    };
+    probabilityAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParamIDs::probability, probabilityKnob);
     probabilityKnob.setSpriteImage(knobSprite, 101);
     addAndMakeVisible(probabilityKnob);
 
@@ -354,11 +398,7 @@ SkaldEditor::SkaldEditor (SkaldProcessor& p)
     addAndMakeVisible(probabilityLabel);
 
     // Velocity variation knob
-    velocityVariationKnob.setRange(0.0, 100.0, 1.0);
-    velocityVariationKnob.setValue(0.0);
-    velocityVariationKnob.onValueChange = [this]() {
-        audioProcessor.setVelocityVariation(static_cast<float>(velocityVariationKnob.getValue()));
-    };
+    velocityVariationAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParamIDs::velocityVariation, velocityVariationKnob);
     velocityVariationKnob.setSpriteImage(knobSprite, 101);
     addAndMakeVisible(velocityVariationKnob);
 
@@ -369,11 +409,7 @@ SkaldEditor::SkaldEditor (SkaldProcessor& p)
     addAndMakeVisible(velocityVariationLabel);
 
     // Swing knob
-    swingKnob.setRange(0.0, 100.0, 1.0);
-    swingKnob.setValue(0.0);
-    swingKnob.onValueChange = [this]() {
-        audioProcessor.setSwing(static_cast<float>(swingKnob.getValue()));
-    };
+    swingAttachment = std::make_unique<SliderAttachment>(audioProcessor.parameters, ParamIDs::swing, swingKnob);
     swingKnob.setSpriteImage(knobSprite, 101);
     addAndMakeVisible(swingKnob);
 
@@ -424,16 +460,9 @@ SkaldEditor::SkaldEditor (SkaldProcessor& p)
                     juce::MemoryBlock data;
                     if (file.loadFileAsData(data))
                     {
+                        // Knobs and toggles follow the loaded parameters via their attachments
                         audioProcessor.setStateInformation(data.getData(), static_cast<int>(data.getSize()));
-
-                        // Update UI to reflect loaded values
-                        velocityKnob.setValue(audioProcessor.getGlobalVelocity(), juce::dontSendNotification);
-                        gateTimeKnob.setValue(audioProcessor.getGateTime(), juce::dontSendNotification);
-                        reverseToggle.setToggleState(audioProcessor.getReverse(), juce::dontSendNotification);
-                        probabilityKnob.setValue(audioProcessor.getProbability(), juce::dontSendNotification);
-                        velocityVariationKnob.setValue(audioProcessor.getVelocityVariation(), juce::dontSendNotification);
-                        swingKnob.setValue(audioProcessor.getSwing(), juce::dontSendNotification);
-
+                        updateSpeedDisplay();
                         repaint();
                     }
                 }
@@ -617,40 +646,26 @@ SkaldEditor::SkaldEditor (SkaldProcessor& p)
         wallpaperImage = scaledWallpaper;
     }
 
+    // Speed can be automated by the host, so the LED display follows the parameter
+    audioProcessor.parameters.addParameterListener(ParamIDs::speed, this);
+
     // Start timer for animation (30 FPS)
     startTimerHz(30);
 }
 
 SkaldEditor::~SkaldEditor()
 {
+    audioProcessor.parameters.removeParameterListener(ParamIDs::speed, this);
     stopTimer();
 }
 
 //==============================================================================
 void SkaldEditor::paint (juce::Graphics& g)
 {
-    // Background - textured wallpaper
-    if (wallpaperImage.isValid())
-    {
-        // Tile the wallpaper to fill the background
-        g.setTiledImageFill(wallpaperImage, 0, 0, 1.0f);
-        g.fillAll();
-    }
-    else
-    {
-        // Fallback to gradient if wallpaper fails to load
-        juce::ColourGradient bgGradient(
-            juce::Colour(0xff1a1a1a), 0, 0,
-            juce::Colour(0xff0d0d0d), 0, static_cast<float>(getHeight()),
-            false
-        );
-        g.setGradientFill(bgGradient);
-        g.fillAll();
-    }
-
     // If showing help screen, paint it and return
     if (showingHelpScreen)
     {
+        paintWallpaper(g);
         paintHelpScreen(g);
         return;
     }
@@ -658,44 +673,29 @@ void SkaldEditor::paint (juce::Graphics& g)
     // Draw turntable
     turntableCenter = turntableArea.getCentre();
 
-    // Main outer ring with modern gradient - thin outer ring
-    juce::ColourGradient metalGradient(
-        juce::Colour(0xff404040), turntableCenter.x - turntableRadius, turntableCenter.y - turntableRadius,
-        juce::Colour(0xff202020), turntableCenter.x + turntableRadius, turntableCenter.y + turntableRadius,
-        false
-    );
-    g.setGradientFill(metalGradient);
-    g.fillEllipse(turntableCenter.x - turntableRadius,
-                  turntableCenter.y - turntableRadius,
-                  turntableRadius * 2.0f,
-                  turntableRadius * 2.0f);
+    // The wallpaper, platter, ring tracks, arm and spindle only change with the
+    // window size, the display scale or the number of rings, so they are drawn
+    // once into images at device resolution and blitted every frame, in layers
+    // around the parts that move
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (!staticLayer.isValid() || scale != staticLayerScale || audioProcessor.getNumRings() != staticLayerNumRings)
+        renderStaticLayers(scale);
+
+    g.drawImageTransformed(staticLayer, juce::AffineTransform::scale(1.0f / scale));
+    glowAtlas.prepare(scale);
 
     // LED indicator ring (shows active dots)
     float ledRingRadius = turntableRadius * 0.96f;
 
     // Draw LED ring segments (like Orbita's LED circle)
-    int numLEDs = 60;
+    updateLedOccupancy();
     for (int i = 0; i < numLEDs; ++i)
     {
         float angle = (i * 360.0f / numLEDs - audioProcessor.getCurrentRotation()) *
                      juce::MathConstants<float>::pi / 180.0f;
 
         // Check if this LED is near a dot
-        bool isActive = false;
-        auto& dots = audioProcessor.getDots();
-        for (const auto& dot : dots)
-        {
-            float ledAngleDeg = std::fmod(i * 360.0f / numLEDs + 360.0f, 360.0f);
-            float dotAngleDeg = std::fmod(dot.angle + 360.0f, 360.0f);
-            float diff = std::abs(ledAngleDeg - dotAngleDeg);
-            if (diff > 180.0f) diff = 360.0f - diff;
-
-            if (diff < 360.0f / numLEDs * 2)
-            {
-                isActive = true;
-                break;
-            }
-        }
+        bool isActive = ledOccupancy[static_cast<size_t>(i)];
 
         auto ledPos = juce::Point<float>(
             turntableCenter.x + std::cos(angle) * ledRingRadius,
@@ -718,141 +718,35 @@ void SkaldEditor::paint (juce::Graphics& g)
         }
     }
 
+    // Ring tracks and arm go over the LED ring
+    g.drawImageTransformed(trackLayer, juce::AffineTransform::scale(1.0f / scale)
+                                           .translated(trackBounds.getX(), trackBounds.getY()));
+
     // Inner surface - much larger, taking up more space
     float innerRadius = turntableRadius * 0.90f;
-
-    // Draw artistic concentric ring tracks with organic variations
-    // Alternating shades with subtle variations
-    juce::Colour ringColors[] = {
-        juce::Colour(0xff1a1a1a),  // Ring 0 - darker grey
-        juce::Colour(0xff252525),  // Ring 1 - lighter grey
-        juce::Colour(0xff1a1a1a),  // Ring 2 - darker grey
-        juce::Colour(0xff252525),  // Ring 3 - lighter grey
-        juce::Colour(0xff1a1a1a),  // Ring 4 - darker grey
-        juce::Colour(0xff252525),  // Ring 5 - lighter grey
-        juce::Colour(0xff1a1a1a),  // Ring 6 - darker grey
-        juce::Colour(0xff252525),  // Ring 7 - lighter grey
-        juce::Colour(0xff1a1a1a),  // Ring 8 - darker grey
-        juce::Colour(0xff252525),  // Ring 9 - lighter grey
-        juce::Colour(0xff1a1a1a),  // Ring 10 - darker grey
-        juce::Colour(0xff252525)   // Ring 11 - lighter grey
-    };
-
     int numRings = audioProcessor.getNumRings();
     float ringSpacing = numRings > 0 ? 0.80f / numRings : 0.15f;
 
-    for (int ring = 0; ring < numRings; ++ring)
-    {
-        // Add stronger organic spacing variation with multiple wave patterns for artistic effect
-        float spacingVariation = 0.018f * std::sin(ring * 1.3f) + 0.008f * std::cos(ring * 2.1f);
-        float ringOuterRadius = innerRadius * (0.95f - ring * ringSpacing + spacingVariation);
-        float ringInnerRadius = innerRadius * (0.95f - (ring + 1) * ringSpacing + spacingVariation);
-
-        // Draw ring track with subtle colored tint
-        g.setColour(ringColors[ring]);
-        juce::Path ringPath;
-        ringPath.addEllipse(turntableCenter.x - ringOuterRadius,
-                           turntableCenter.y - ringOuterRadius,
-                           ringOuterRadius * 2, ringOuterRadius * 2);
-        juce::Path innerHole;
-        innerHole.addEllipse(turntableCenter.x - ringInnerRadius,
-                            turntableCenter.y - ringInnerRadius,
-                            ringInnerRadius * 2, ringInnerRadius * 2);
-        ringPath.addPath(innerHole);
-        ringPath.setUsingNonZeroWinding(false);
-        g.fillPath(ringPath);
-
-        // Draw artistic ring separator with more dramatic thickness variation and multiple overlays
-        float lineThickness = 1.2f + (ring % 4) * 0.6f + 0.3f * std::sin(ring * 0.7f);  // More dramatic varying thickness
-
-        // Draw multiple slightly offset circles for hand-drawn organic feel
-        for (int layer = 0; layer < 2; ++layer)
-        {
-            float offset = layer * 0.15f;
-            float alpha = layer == 0 ? 0.6f : 0.3f;
-            g.setColour(juce::Colour(0xff2a2a2a).withAlpha(alpha));
-            g.drawEllipse(turntableCenter.x - ringOuterRadius + offset,
-                         turntableCenter.y - ringOuterRadius + offset,
-                         ringOuterRadius * 2 - offset * 2, ringOuterRadius * 2 - offset * 2,
-                         lineThickness);
-        }
-    }
-
-    // Draw crossbar sensor arm (connects center to edge)
-    // Arm positioned at -90 degrees (top)
-    float armAngle = -90.0f * juce::MathConstants<float>::pi / 180.0f;
-
-    // Arm starts at center
-    auto armStart = juce::Point<float>(
-        turntableCenter.x,
-        turntableCenter.y
-    );
-
-    // Arm extends to outer edge
-    auto armEnd = juce::Point<float>(
-        turntableCenter.x + std::cos(armAngle) * (turntableRadius + 10),
-        turntableCenter.y + std::sin(armAngle) * (turntableRadius + 10)
-    );
-
-    float armWidth = 8.0f; // Wider arm
-
-    // Draw main metal arm with gradient
-    juce::ColourGradient armGradient(
-        juce::Colour(0xff5a5a5a), armStart.x - armWidth, armStart.y,
-        juce::Colour(0xff3a3a3a), armStart.x + armWidth, armStart.y,
-        false
-    );
-    g.setGradientFill(armGradient);
-
-    juce::Path armPath;
-    armPath.startNewSubPath(armStart.x - armWidth, armStart.y);
-    armPath.lineTo(armEnd.x - armWidth, armEnd.y);
-    armPath.lineTo(armEnd.x + armWidth, armEnd.y);
-    armPath.lineTo(armStart.x + armWidth, armStart.y);
-    armPath.closeSubPath();
-    g.fillPath(armPath);
-
-    // Arm edge highlights
-    g.setColour(juce::Colour(0xff6a6a6a).withAlpha(0.5f));
-    g.strokePath(armPath, juce::PathStrokeType(1.0f));
-
-    // Mounting bracket at edge (larger)
-    g.setColour(juce::Colour(0xff3a3a3a));
-    g.fillEllipse(armStart.x - 8, armStart.y - 8, 16, 16);
-    g.setColour(juce::Colour(0xff6a6a6a));
-    g.drawEllipse(armStart.x - 8, armStart.y - 8, 16, 16, 2.0f);
-
     // Check which dots are passing under the arm (at visual angle 0 degrees - top)
-    auto& dots = audioProcessor.getDots();
+    const auto& dots = audioProcessor.getDots();
     float armVisualAngle = 0.0f; // The arm is at the top (0 degrees) visually
     float currentRotation = audioProcessor.getCurrentRotation();
 
     // Draw glow on arm where dots are passing under it (only for triggered notes)
-    auto triggeredDotsForArm = audioProcessor.getRecentlyTriggeredDots();
-    auto currentTimeForArm = juce::Time::currentTimeMillis();
-
-    for (size_t i = 0; i < dots.size(); ++i)
+    for (auto slot : recentTriggerSlots)
     {
-        if (!dots[i].active)
-            continue;
-
-        // Find trigger info for this dot
-        const SkaldProcessor::TriggeredDotInfo* triggerInfo = nullptr;
-        for (const auto& info : triggeredDotsForArm)
-        {
-            if (info.dotIndex == static_cast<int>(i) && (currentTimeForArm - info.timestamp) <= 200)
-            {
-                triggerInfo = &info;
-                break;
-            }
-        }
+        const auto* triggerInfo = &triggerHistory[static_cast<size_t>(recentTriggerBySlot[slot])];
 
         // Only show glow if dot was actually triggered (probability passed)
-        if (triggerInfo == nullptr || !triggerInfo->wasTriggered)
+        if (!triggerInfo->wasTriggered)
+            continue;
+
+        const auto* dot = dots.find(triggerInfo->dotId);
+        if (dot == nullptr || !dot->active)
             continue;
 
         // Calculate the visual angle of this dot (where it appears after rotation)
-        float visualAngle = dots[i].angle - currentRotation;
+        float visualAngle = dot->angle - currentRotation;
 
         // Normalize to 0-360
         visualAngle = std::fmod(visualAngle + 360.0f, 360.0f);
@@ -874,7 +768,7 @@ void SkaldEditor::paint (juce::Graphics& g)
             float velocityBrightness = calculateGlowBrightness(triggerInfo->velocity);
             glowIntensity *= velocityBrightness;
 
-            int ringIndex = dots[i].ringIndex;
+            int ringIndex = dot->ringIndex;
             float ringOuterRadius = innerRadius * (0.95f - ringIndex * ringSpacing);
             float ringInnerRadius = innerRadius * (0.95f - (ringIndex + 1) * ringSpacing);
             float ringMidRadius = (ringOuterRadius + ringInnerRadius) / 2.0f;
@@ -886,15 +780,9 @@ void SkaldEditor::paint (juce::Graphics& g)
                 turntableCenter.y + std::sin(effectiveArmAngleRad) * ringMidRadius
             );
 
-            // Draw smooth cyan glow with velocity-based brightness (more rings for smoother fade)
-            for (int glow = 6; glow >= 0; --glow)
-            {
-                float glowSize = (6.0f + glow * 3.0f) * glowIntensity;
-                float alpha = (0.35f - glow * 0.045f) * glowIntensity;  // Higher alpha for more visible glow
-                g.setColour(juce::Colour(0xff00d9ff).withAlpha(alpha));
-                g.fillEllipse(glowPos.x - glowSize, glowPos.y - glowSize,
-                            glowSize * 2, glowSize * 2);
-            }
+            // Draw smooth cyan glow with velocity-based brightness
+            glowAtlas.draw(g, GlowAtlas::armGlow, glowPos, 24.0f * glowIntensity,
+                           juce::Colour(0xff00d9ff).withAlpha(glowIntensity));
 
             // Bright glowing center
             g.setColour(juce::Colour(0xff00d9ff).withAlpha(1.0f * glowIntensity));
@@ -902,32 +790,19 @@ void SkaldEditor::paint (juce::Graphics& g)
         }
     }
 
-    // Get recently triggered dots for visual feedback
-    auto triggeredDots = audioProcessor.getRecentlyTriggeredDots();
-    auto currentTime = juce::Time::currentTimeMillis();
-
-    // Helper to find triggered info for a dot
-    auto findTriggeredInfo = [&triggeredDots, currentTime](int index) -> const SkaldProcessor::TriggeredDotInfo* {
-        for (const auto& info : triggeredDots)
-        {
-            if (info.dotIndex == index && (currentTime - info.timestamp) <= 200)
-                return &info;
-        }
-        return nullptr;
-    };
-
     // Draw gate time tracer effect (fading glow trail)
-    for (const auto& triggerInfo : triggeredDots)
+    for (const auto& triggerInfo : triggerHistory)
     {
         if (!triggerInfo.wasTriggered)
             continue; // Only show tracers for actually triggered notes
 
-        int dotIndex = triggerInfo.dotIndex;
-        if (dotIndex < 0 || dotIndex >= static_cast<int>(dots.size()) || !dots[dotIndex].active)
+        // The dot may have been removed since it triggered
+        const auto* dot = dots.find(triggerInfo.dotId);
+        if (dot == nullptr || !dot->active)
             continue;
 
         // Calculate age of this trigger
-        float ageMs = static_cast<float>(currentTime - triggerInfo.timestamp);
+        float ageMs = getTriggerAgeMs(triggerInfo);
         float fadeProgress = ageMs / triggerInfo.gateTimeMs;  // 0.0 = just triggered, 1.0 = gate expired
 
         if (fadeProgress >= 1.0f)
@@ -946,14 +821,14 @@ void SkaldEditor::paint (juce::Graphics& g)
         float triggerRotation = currentRotation - rotationSinceTrigger;
 
         // Calculate ring positions
-        int ringIndex = dots[dotIndex].ringIndex;
+        int ringIndex = dot->ringIndex;
         float spacing = getRingSpacing();
         float ringOuterRadius = innerRadius * (0.95f - ringIndex * spacing);
         float ringInnerRadius = innerRadius * (0.95f - (ringIndex + 1) * spacing);
         float ringMidRadius = (ringOuterRadius + ringInnerRadius) / 2.0f;
 
         // Draw tracer at the trigger position (where dot was when it triggered)
-        float angleInOurSystem = dots[dotIndex].angle - triggerRotation;
+        float angleInOurSystem = dot->angle - triggerRotation;
         float angleInStandardMath = angleInOurSystem - 90.0f;
         float visualAngle = angleInStandardMath * juce::MathConstants<float>::pi / 180.0f;
         auto tracerPos = juce::Point<float>(
@@ -967,113 +842,407 @@ void SkaldEditor::paint (juce::Graphics& g)
 
         // Draw fading glow (like it's "burning out")
         float tracerSize = 4.0f;
-        for (int glowRing = 2; glowRing >= 0; --glowRing)
-        {
-            float glowSize = tracerSize * (1.5f + glowRing * 0.4f);
-            float alpha = (0.08f + glowRing * 0.02f) * tracerAlpha * velocityBrightness;
-            g.setColour(dots[dotIndex].color.withAlpha(alpha));
-            g.fillEllipse(tracerPos.x - glowSize, tracerPos.y - glowSize, glowSize * 2, glowSize * 2);
-        }
+        glowAtlas.draw(g, GlowAtlas::tracerGlow, tracerPos, tracerSize * 2.3f,
+                       dot->color.withAlpha(tracerAlpha * velocityBrightness));
 
         // Fading core
-        g.setColour(dots[dotIndex].color.withAlpha(0.4f * tracerAlpha * velocityBrightness));
+        g.setColour(dot->color.withAlpha(0.4f * tracerAlpha * velocityBrightness));
         g.fillEllipse(tracerPos.x - tracerSize / 2, tracerPos.y - tracerSize / 2, tracerSize, tracerSize);
     }
 
-    // Draw dots as lights shining from underneath (Drum Buddy style!)
-    for (size_t i = 0; i < dots.size(); ++i)
-    {
-        if (!dots[i].active)
-            continue;
+    // Draw dots as lights shining from underneath (Drum Buddy style!). They are drawn
+    // once in pattern space and turned into place with a single transform.
+    updateDotLayer(scale);
+    g.drawImageTransformed(dotLayer, juce::AffineTransform::scale(1.0f / scale)
+                                         .translated(-dotLayerHalfSize, -dotLayerHalfSize)
+                                         .rotated(-currentRotation * juce::MathConstants<float>::pi / 180.0f)
+                                         .translated(turntableCenter));
 
-        // Calculate position on the appropriate ring
-        int ringIndex = dots[i].ringIndex;
-        float spacing = getRingSpacing();
-        float ringOuterRadius = innerRadius * (0.95f - ringIndex * spacing);
-        float ringInnerRadius = innerRadius * (0.95f - (ringIndex + 1) * spacing);
-        float ringMidRadius = (ringOuterRadius + ringInnerRadius) / 2.0f;
-
-        // Convert angle to position (accounting for current rotation)
-        // Angles are stored in our system where 0° = top
-        // cos/sin expect standard math where 0° = right
-        // So we subtract 90° to convert: standard = our - 90°
-        float angleInOurSystem = dots[i].angle - audioProcessor.getCurrentRotation();
-        float angleInStandardMath = angleInOurSystem - 90.0f;
-        float visualAngle = angleInStandardMath * juce::MathConstants<float>::pi / 180.0f;
+    // Lit and selected dots are drawn again on top, in their current state
+    auto paintLiveDot = [&](const TurntableDot& dot, const SkaldProcessor::TriggeredDotInfo* triggerInfo)
+    {
+        float visualAngle = (dot.angle - currentRotation - 90.0f) * juce::MathConstants<float>::pi / 180.0f;
+        float ringMidRadius = getRingMidRadius(dot.ringIndex);
         auto dotPos = juce::Point<float>(
             turntableCenter.x + std::cos(visualAngle) * ringMidRadius,
             turntableCenter.y + std::sin(visualAngle) * ringMidRadius
         );
+        paintDotLight(g, dot, dotPos, dot.id == selectedDotId, triggerInfo);
+    };
 
-        // Check if this dot was recently triggered and get trigger info
-        const auto* triggerInfo = findTriggeredInfo(static_cast<int>(i));
-        bool isPulsing = (triggerInfo != nullptr && triggerInfo->wasTriggered);
+    for (auto slot : recentTriggerSlots)
+    {
+        const auto& triggerInfo = triggerHistory[static_cast<size_t>(recentTriggerBySlot[slot])];
+        if (!triggerInfo.wasTriggered)
+            continue;
 
-        // Calculate brightness based on velocity (only for triggered dots)
-        float velocityBrightness = 1.0f;
-        if (isPulsing)
-        {
-            velocityBrightness = calculateGlowBrightness(triggerInfo->velocity);
-        }
+        const auto* dot = dots.find(triggerInfo.dotId);
+        if (dot != nullptr && dot->active)
+            paintLiveDot(*dot, &triggerInfo);
+    }
 
-        // Smooth pulse fade based on time since trigger (not binary on/off)
-        float pulseAmount = 1.0f;
-        if (isPulsing && triggerInfo)
-        {
-            float timeSinceTrigger = (currentTime - triggerInfo->timestamp) / 1000.0f;
-            // Smooth fade from 2.5x to 1.0x over 200ms
-            pulseAmount = 1.0f + (1.5f * velocityBrightness * juce::jmax(0.0f, 1.0f - (timeSinceTrigger * 5.0f)));
-        }
+    if (const auto* dot = dots.find(selectedDotId); dot != nullptr && dot->active)
+    {
+        const auto* triggerInfo = findRecentTrigger(selectedDotId);
+        if (triggerInfo == nullptr || !triggerInfo->wasTriggered)
+            paintLiveDot(*dot, triggerInfo);
+    }
+
+    // Spindle goes over the dots
+    g.drawImageTransformed(spindleLayer, juce::AffineTransform::scale(1.0f / scale)
+                                             .translated(spindleBounds.getX(), spindleBounds.getY()));
+}
+
+void SkaldEditor::paintDotLight(juce::Graphics& g, const TurntableDot& dot, juce::Point<float> dotPos,
+                                bool isSelected, const SkaldProcessor::TriggeredDotInfo* triggerInfo)
+{
+    // triggerInfo is the dot's trigger from the last 200ms, if it had one
+    bool isPulsing = (triggerInfo != nullptr && triggerInfo->wasTriggered);
+
+    // Calculate brightness based on velocity (only for triggered dots)
+    float velocityBrightness = 1.0f;
+    if (isPulsing)
+    {
+        velocityBrightness = calculateGlowBrightness(triggerInfo->velocity);
+    }
+
+    // Smooth pulse fade based on time since trigger (not binary on/off)
+    float pulseAmount = 1.0f;
+    if (isPulsing && triggerInfo)
+    {
+        float timeSinceTrigger = getTriggerAgeMs(*triggerInfo) / 1000.0f;
+        // Smooth fade from 2.5x to 1.0x over 200ms
+        pulseAmount = 1.0f + (1.5f * velocityBrightness * juce::jmax(0.0f, 1.0f - (timeSinceTrigger * 5.0f)));
+    }
+
+    float dotSize = isSelected ? 6.0f : 4.5f;
+    if (isPulsing) dotSize *= 1.2f;
+
+    // LIGHT FROM UNDERNEATH EFFECT - a soft glow, much fainter while the dot is at rest
+    glowAtlas.draw(g, GlowAtlas::dotGlow, dotPos, dotSize * 3.9f * pulseAmount,
+                   dot.color.withAlpha(isPulsing ? 1.0f : 0.32f));
 
-        float dotSize = (selectedDotIndex == static_cast<int>(i)) ? 6.0f : 4.5f;
-        if (isPulsing) dotSize *= 1.2f;
+    // Bright center (the actual light hole)
+    float brightnessBoost = isPulsing ? 0.8f : 0.4f;
+    juce::ColourGradient lightGradient(
+        dot.color.brighter(brightnessBoost).withAlpha(isPulsing ? 1.0f : 0.9f), dotPos.x, dotPos.y,
+        dot.color.withAlpha(isPulsing ? 0.8f : 0.5f), dotPos.x, dotPos.y + dotSize,
+        true
+    );
+    g.setGradientFill(lightGradient);
+    g.fillEllipse(dotPos.x - dotSize / 2, dotPos.y - dotSize / 2, dotSize, dotSize);
+
+    // Small bright core (like looking at a small bulb through hole)
+    float coreAlpha = (isSelected || isPulsing) ? 0.9f : 0.4f;
+    g.setColour(juce::Colours::white.withAlpha(coreAlpha));
+    if (isSelected || isPulsing)
+    {
+        g.fillEllipse(dotPos.x - dotSize / 3, dotPos.y - dotSize / 3, dotSize / 1.5f, dotSize / 1.5f);
+    }
+    else
+    {
+        g.fillEllipse(dotPos.x - 1, dotPos.y - 1, 2, 2);
+    }
 
-        // LIGHT FROM UNDERNEATH EFFECT - Smooth glowing with more rings for softer edges
-        for (int glowRing = 6; glowRing >= 0; --glowRing)
+    // Note label when selected
+    if (isSelected)
+    {
+        g.setColour(juce::Colour(0xff00d9ff));
+        g.setFont(juce::FontOptions("Arial", 10.0f, juce::Font::bold));
+        int midiNote = audioProcessor.ringToMidiNote(dot.ringIndex);
+        juce::String noteText = midiNoteToString(midiNote);
+        g.drawText(noteText,
+                  static_cast<int>(dotPos.x - 40),
+                  static_cast<int>(dotPos.y + dotSize + 2),
+                  80, 14,
+                  juce::Justification::centred);
+    }
+}
+
+void SkaldEditor::updateLedOccupancy()
+{
+    if (ledOccupancyValid && audioProcessor.getPatternVersion() == ledOccupancyVersion)
+        return;
+
+    // An LED lights when any dot is less than two LEDs away from it, so only the
+    // LEDs either side of the nearest one need testing
+    ledOccupancy.reset();
+    for (const auto& dot : audioProcessor.getDots())
+    {
+        float dotAngleDeg = PatternSnapshot::normaliseAngle(dot.angle);
+        int nearestLED = juce::roundToInt(dotAngleDeg * numLEDs / 360.0f);
+
+        for (int led = nearestLED - 2; led <= nearestLED + 2; ++led)
         {
-            float glowSize = dotSize * (1.5f + glowRing * 0.4f) * pulseAmount;
-            float alpha = (isPulsing ? 0.25f : 0.08f) * (1.0f - (glowRing / 7.0f));  // Smooth gradient
-            g.setColour(dots[i].color.withAlpha(alpha));
-            g.fillEllipse(dotPos.x - glowSize, dotPos.y - glowSize, glowSize * 2, glowSize * 2);
+            int i = ((led % numLEDs) + numLEDs) % numLEDs;
+            float ledAngleDeg = std::fmod(i * 360.0f / numLEDs + 360.0f, 360.0f);
+            float diff = std::abs(ledAngleDeg - dotAngleDeg);
+            if (diff > 180.0f) diff = 360.0f - diff;
+
+            if (diff < 360.0f / numLEDs * 2)
+                ledOccupancy.set(static_cast<size_t>(i));
         }
+    }
+
+    ledOccupancyVersion = audioProcessor.getPatternVersion();
+    ledOccupancyValid = true;
+}
+
+float SkaldEditor::getRingMidRadius(int ringIndex) const
+{
+    float innerRadius = turntableRadius * 0.90f;
+    float spacing = getRingSpacing();
+    float ringOuterRadius = innerRadius * (0.95f - ringIndex * spacing);
+    float ringInnerRadius = innerRadius * (0.95f - (ringIndex + 1) * spacing);
+    return (ringOuterRadius + ringInnerRadius) / 2.0f;
+}
+
+void SkaldEditor::updatePlacedDots()
+{
+    if (audioProcessor.getPatternVersion() == placedDotsVersion && audioProcessor.getNumRings() == placedDotsNumRings
+        && turntableRadius == placedDotsRadius)
+        return;
+
+    // Angles are stored in our system where 0° = top
+    // cos/sin expect standard math where 0° = right
+    // So we subtract 90° to convert: standard = our - 90°
+    placedDots.clear();
+    for (const auto& dot : audioProcessor.getDots())
+    {
+        if (!dot.active)
+            continue;
+
+        float angleInStandardMath = (dot.angle - 90.0f) * juce::MathConstants<float>::pi / 180.0f;
+        float ringMidRadius = getRingMidRadius(dot.ringIndex);
+        placedDots.push_back({ dot.id, { std::cos(angleInStandardMath) * ringMidRadius,
+                                         std::sin(angleInStandardMath) * ringMidRadius } });
+    }
+
+    placedDotsVersion = audioProcessor.getPatternVersion();
+    placedDotsNumRings = audioProcessor.getNumRings();
+    placedDotsRadius = turntableRadius;
+    dotLayer = {};
+}
+
+void SkaldEditor::updateDotLayer(float scale)
+{
+    updatePlacedDots();
+    if (dotLayer.isValid() && scale == dotLayerScale)
+        return;
+
+    // Room for the outermost ring plus the widest glow
+    dotLayerHalfSize = turntableRadius * 0.90f + 20.0f;
+    const int size = juce::jmax(1, juce::roundToInt(2.0f * dotLayerHalfSize * scale));
+    dotLayer = juce::Image(juce::Image::ARGB, size, size, true);
+
+    juce::Graphics layer(dotLayer);
+    layer.addTransform(juce::AffineTransform::translation(dotLayerHalfSize, dotLayerHalfSize).scaled(scale));
+
+    const auto& dots = audioProcessor.getDots();
+    for (const auto& placed : placedDots)
+        if (const auto* dot = dots.find(placed.id))
+            paintDotLight(layer, *dot, placed.position, false, nullptr);
+
+    dotLayerScale = scale;
+}
 
-        // Bright center (the actual light hole)
-        float brightnessBoost = isPulsing ? 0.8f : 0.4f;
-        juce::ColourGradient lightGradient(
-            dots[i].color.brighter(brightnessBoost).withAlpha(isPulsing ? 1.0f : 0.9f), dotPos.x, dotPos.y,
-            dots[i].color.withAlpha(isPulsing ? 0.8f : 0.5f), dotPos.x, dotPos.y + dotSize,
-            true
+void SkaldEditor::paintWallpaper(juce::Graphics& g)
+{
+    // Background - textured wallpaper
+    if (wallpaperImage.isValid())
+    {
+        // Tile the wallpaper to fill the background
+        g.setTiledImageFill(wallpaperImage, 0, 0, 1.0f);
+        g.fillAll();
+    }
+    else
+    {
+        // Fallback to gradient if wallpaper fails to load
+        juce::ColourGradient bgGradient(
+            juce::Colour(0xff1a1a1a), 0, 0,
+            juce::Colour(0xff0d0d0d), 0, static_cast<float>(getHeight()),
+            false
         );
-        g.setGradientFill(lightGradient);
-        g.fillEllipse(dotPos.x - dotSize / 2, dotPos.y - dotSize / 2, dotSize, dotSize);
+        g.setGradientFill(bgGradient);
+        g.fillAll();
+    }
+}
 
-        // Small bright core (like looking at a small bulb through hole)
-        float coreAlpha = (selectedDotIndex == static_cast<int>(i) || isPulsing) ? 0.9f : 0.4f;
-        g.setColour(juce::Colours::white.withAlpha(coreAlpha));
-        if (selectedDotIndex == static_cast<int>(i) || isPulsing)
-        {
-            g.fillEllipse(dotPos.x - dotSize / 3, dotPos.y - dotSize / 3, dotSize / 1.5f, dotSize / 1.5f);
-        }
-        else
-        {
-            g.fillEllipse(dotPos.x - 1, dotPos.y - 1, 2, 2);
-        }
+void SkaldEditor::renderStaticLayers(float scale)
+{
+    // The wallpaper and the platter's rim, covering the whole editor
+    staticLayer = juce::Image(juce::Image::RGB,
+                              juce::jmax(1, juce::roundToInt(static_cast<float>(getWidth()) * scale)),
+                              juce::jmax(1, juce::roundToInt(static_cast<float>(getHeight()) * scale)),
+                              false);
+    {
+        juce::Graphics layer(staticLayer);
+        layer.addTransform(juce::AffineTransform::scale(scale));
+        paintWallpaper(layer);
+        paintTurntableBase(layer);
+    }
 
-        // Note label when selected
-        if (selectedDotIndex == static_cast<int>(i))
+    // The ring tracks and arm are drawn over the LED ring, so they get a
+    // transparent image of their own, just big enough for the platter and arm
+    trackBounds = juce::Rectangle<float>(turntableCenter.x - turntableRadius, turntableCenter.y - turntableRadius,
+                                         turntableRadius * 2.0f, turntableRadius * 2.0f)
+                      .expanded(12.0f)  // The arm reaches 10 past the rim
+                      .getSmallestIntegerContainer();
+    trackLayer = juce::Image(juce::Image::ARGB,
+                             juce::jmax(1, juce::roundToInt(static_cast<float>(trackBounds.getWidth()) * scale)),
+                             juce::jmax(1, juce::roundToInt(static_cast<float>(trackBounds.getHeight()) * scale)),
+                             true);
+    {
+        juce::Graphics layer(trackLayer);
+        layer.addTransform(juce::AffineTransform::translation(static_cast<float>(-trackBounds.getX()),
+                                                              static_cast<float>(-trackBounds.getY()))
+                                                 .scaled(scale));
+        paintRingTracksAndArm(layer);
+    }
+
+    // The spindle is drawn over the dots, so it gets a small image of its own
+    spindleBounds = juce::Rectangle<float>(turntableCenter.x - 20, turntableCenter.y - 20, 40, 40)
+                        .getSmallestIntegerContainer();
+    spindleLayer = juce::Image(juce::Image::ARGB,
+                               juce::jmax(1, juce::roundToInt(static_cast<float>(spindleBounds.getWidth()) * scale)),
+                               juce::jmax(1, juce::roundToInt(static_cast<float>(spindleBounds.getHeight()) * scale)),
+                               true);
+    {
+        juce::Graphics layer(spindleLayer);
+        layer.addTransform(juce::AffineTransform::translation(static_cast<float>(-spindleBounds.getX()),
+                                                              static_cast<float>(-spindleBounds.getY()))
+                                                 .scaled(scale));
+        paintSpindle(layer);
+    }
+
+    staticLayerScale = scale;
+    staticLayerNumRings = audioProcessor.getNumRings();
+}
+
+void SkaldEditor::paintTurntableBase(juce::Graphics& g)
+{
+    // Main outer ring with modern gradient - thin outer ring
+    juce::ColourGradient metalGradient(
+        juce::Colour(0xff404040), turntableCenter.x - turntableRadius, turntableCenter.y - turntableRadius,
+        juce::Colour(0xff202020), turntableCenter.x + turntableRadius, turntableCenter.y + turntableRadius,
+        false
+    );
+    g.setGradientFill(metalGradient);
+    g.fillEllipse(turntableCenter.x - turntableRadius,
+                  turntableCenter.y - turntableRadius,
+                  turntableRadius * 2.0f,
+                  turntableRadius * 2.0f);
+}
+
+void SkaldEditor::paintRingTracksAndArm(juce::Graphics& g)
+{
+    // Inner surface - much larger, taking up more space
+    float innerRadius = turntableRadius * 0.90f;
+
+    // Draw artistic concentric ring tracks with organic variations
+    // Alternating shades with subtle variations
+    juce::Colour ringColors[] = {
+        juce::Colour(0xff1a1a1a),  // Ring 0 - darker grey
+        juce::Colour(0xff252525),  // Ring 1 - lighter grey
+        juce::Colour(0xff1a1a1a),  // Ring 2 - darker grey
+        juce::Colour(0xff252525),  // Ring 3 - lighter grey
+        juce::Colour(0xff1a1a1a),  // Ring 4 - darker grey
+        juce::Colour(0xff252525),  // Ring 5 - lighter grey
+        juce::Colour(0xff1a1a1a),  // Ring 6 - darker grey
+        juce::Colour(0xff252525),  // Ring 7 - lighter grey
+        juce::Colour(0xff1a1a1a),  // Ring 8 - darker grey
+        juce::Colour(0xff252525),  // Ring 9 - lighter grey
+        juce::Colour(0xff1a1a1a),  // Ring 10 - darker grey
+        juce::Colour(0xff252525)   // Ring 11 - lighter grey
+    };
+
+    int numRings = audioProcessor.getNumRings();
+    float ringSpacing = numRings > 0 ? 0.80f / numRings : 0.15f;
+
+    for (int ring = 0; ring < numRings; ++ring)
+    {
+        // Add stronger organic spacing variation with multiple wave patterns for artistic effect
+        float spacingVariation = 0.018f * std::sin(ring * 1.3f) + 0.008f * std::cos(ring * 2.1f);
+        float ringOuterRadius = innerRadius * (0.95f - ring * ringSpacing + spacingVariation);
+        float ringInnerRadius = innerRadius * (0.95f - (ring + 1) * ringSpacing + spacingVariation);
+
+        // Draw ring track with subtle colored tint
+        g.setColour(ringColors[ring]);
+        juce::Path ringPath;
+        ringPath.addEllipse(turntableCenter.x - ringOuterRadius,
+                           turntableCenter.y - ringOuterRadius,
+                           ringOuterRadius * 2, ringOuterRadius * 2);
+        juce::Path innerHole;
+        innerHole.addEllipse(turntableCenter.x - ringInnerRadius,
+                            turntableCenter.y - ringInnerRadius,
+                            ringInnerRadius * 2, ringInnerRadius * 2);
+        ringPath.addPath(innerHole);
+        ringPath.setUsingNonZeroWinding(false);
+        g.fillPath(ringPath);
+
+        // Draw artistic ring separator with more dramatic thickness variation and multiple overlays
+        float lineThickness = 1.2f + (ring % 4) * 0.6f + 0.3f * std::sin(ring * 0.7f);  // More dramatic varying thickness
+
+        // Draw multiple slightly offset circles for hand-drawn organic feel
+        for (int layer = 0; layer < 2; ++layer)
         {
-            g.setColour(juce::Colour(0xff00d9ff));
-            g.setFont(juce::FontOptions("Arial", 10.0f, juce::Font::bold));
-            int midiNote = audioProcessor.ringToMidiNote(ringIndex);
-            juce::String noteText = midiNoteToString(midiNote);
-            g.drawText(noteText,
-                      static_cast<int>(dotPos.x - 40),
-                      static_cast<int>(dotPos.y + dotSize + 2),
-                      80, 14,
-                      juce::Justification::centred);
+            float offset = layer * 0.15f;
+            float alpha = layer == 0 ? 0.6f : 0.3f;
+            g.setColour(juce::Colour(0xff2a2a2a).withAlpha(alpha));
+            g.drawEllipse(turntableCenter.x - ringOuterRadius + offset,
+                         turntableCenter.y - ringOuterRadius + offset,
+                         ringOuterRadius * 2 - offset * 2, ringOuterRadius * 2 - offset * 2,
+                         lineThickness);
         }
     }
 
+    // Draw crossbar sensor arm (connects center to edge)
+    // Arm positioned at -90 degrees (top)
+    float armAngle = -90.0f * juce::MathConstants<float>::pi / 180.0f;
+
+    // Arm starts at center
+    auto armStart = juce::Point<float>(
+        turntableCenter.x,
+        turntableCenter.y
+    );
+
+    // Arm extends to outer edge
+    auto armEnd = juce::Point<float>(
+        turntableCenter.x + std::cos(armAngle) * (turntableRadius + 10),
+        turntableCenter.y + std::sin(armAngle) * (turntableRadius + 10)
+    );
+
+    float armWidth = 8.0f; // Wider arm
+
+    // Draw main metal arm with gradient
+    juce::ColourGradient armGradient(
+        juce::Colour(0xff5a5a5a), armStart.x - armWidth, armStart.y,
+        juce::Colour(0xff3a3a3a), armStart.x + armWidth, armStart.y,
+        false
+    );
+    g.setGradientFill(armGradient);
+
+    juce::Path armPath;
+    armPath.startNewSubPath(armStart.x - armWidth, armStart.y);
+    armPath.lineTo(armEnd.x - armWidth, armEnd.y);
+    armPath.lineTo(armEnd.x + armWidth, armEnd.y);
+    armPath.lineTo(armStart.x + armWidth, armStart.y);
+    armPath.closeSubPath();
+    g.fillPath(armPath);
+
+    // Arm edge highlights
+    g.setColour(juce::Colour(0xff6a6a6a).withAlpha(0.5f));
+    g.strokePath(armPath, juce::PathStrokeType(1.0f));
+
+    // Mounting bracket at edge (larger)
+    g.setColour(juce::Colour(0xff3a3a3a));
+    g.fillEllipse(armStart.x - 8, armStart.y - 8, 16, 16);
+    g.setColour(juce::Colour(0xff6a6a6a));
+    g.drawEllipse(armStart.x - 8, armStart.y - 8, 16, 16, 2.0f);
+}
+
+void SkaldEditor::paintSpindle(juce::Graphics& g)
+{
     // Draw center spindle (like vinyl record center)
     juce::ColourGradient spindleGradient(
         juce::Colour(0xff6a6a6a), turntableCenter.x - 20, turntableCenter.y - 20,
@@ -1448,6 +1617,7 @@ void SkaldEditor::resized()
 
     turntableArea = juce::Rectangle<float>(turntableX, turntableY, turntableSize, turntableSize);
     turntableRadius = turntableSize / 2.0f * 0.92f;
+    staticLayer = {};  // Redrawn at the new size on the next paint
 
     // Position action buttons in bottom right
     const int buttonSize = 32;
@@ -1558,16 +1728,16 @@ void SkaldEditor::mouseDown (const juce::MouseEvent& event)
     }
 
     // Check if we clicked on an existing dot
-    selectedDotIndex = findDotAtPoint(clickPos);
+    selectedDotId = findDotAtPoint(clickPos);
 
     // Double-click handling
     if (event.getNumberOfClicks() == 2)
     {
-        if (selectedDotIndex >= 0)
+        if (selectedDotId != invalidDotId)
         {
             // Double-click on existing dot = delete
-            audioProcessor.removeDot(selectedDotIndex);
-            selectedDotIndex = -1;
+            audioProcessor.removeDot(selectedDotId);
+            selectedDotId = invalidDotId;
             repaint();
             return;
         }
@@ -1629,16 +1799,15 @@ void SkaldEditor::mouseDown (const juce::MouseEvent& event)
         }
     }
 
-    if (selectedDotIndex >= 0)
+    if (selectedDotId != invalidDotId)
     {
         // Start dragging existing dot
         isDraggingDot = true;
 
         // Trigger preview note for selected dot
-        auto& dots = audioProcessor.getDots();
-        if (selectedDotIndex < static_cast<int>(dots.size()))
+        if (const auto* dot = audioProcessor.getDots().find(selectedDotId))
         {
-            audioProcessor.triggerPreviewNote(dots[selectedDotIndex].ringIndex);
+            audioProcessor.triggerPreviewNote(dot->ringIndex);
         }
     }
     else
@@ -1731,25 +1900,23 @@ void SkaldEditor::mouseDrag (const juce::MouseEvent& event)
         return;
     }
 
-    if (isDraggingDot && selectedDotIndex >= 0)
+    if (isDraggingDot && selectedDotId != invalidDotId)
     {
-        auto& dots = audioProcessor.getDots();
-        if (selectedDotIndex < static_cast<int>(dots.size()))
+        if (const auto* dot = audioProcessor.getDots().find(selectedDotId))
         {
             // Calculate which ring we're over
             float innerRadius = turntableRadius * 0.90f;
             auto delta = event.position - turntableCenter;
             float distanceFromCenter = delta.getDistanceFromOrigin();
 
-            // Update angle
+            // New angle
             float angle = angleFromPoint(event.position);
-            dots[selectedDotIndex].angle = angle;
 
             // Check if we moved to a different ring
             int numRings = audioProcessor.getNumRings();
             float ringSpacing = numRings > 0 ? 0.80f / numRings : 0.15f;
 
-            int newRingIndex = dots[selectedDotIndex].ringIndex;
+            int newRingIndex = dot->ringIndex;
             for (int ring = 0; ring < numRings; ++ring)
             {
                 float ringOuterRadius = innerRadius * (0.95f - ring * ringSpacing);
@@ -1762,12 +1929,14 @@ void SkaldEditor::mouseDrag (const juce::MouseEvent& event)
                 }
             }
 
-            // Update ring and trigger preview if ring changed
-            if (newRingIndex != dots[selectedDotIndex].ringIndex)
-            {
-                dots[selectedDotIndex].ringIndex = newRingIndex;
+            // Trigger preview if ring changed
+            bool ringChanged = (newRingIndex != dot->ringIndex);
+
+            // Publish the edit to the audio thread
+            audioProcessor.moveDot(selectedDotId, angle, newRingIndex);
+
+            if (ringChanged)
                 audioProcessor.triggerPreviewNote(newRingIndex);
-            }
 
             repaint();
         }
@@ -1776,13 +1945,71 @@ void SkaldEditor::mouseDrag (const juce::MouseEvent& event)
 
 void SkaldEditor::timerCallback()
 {
+    // Collect this frame's trigger telemetry (lock-free) and forget entries older than
+    // 1000ms (long enough to accommodate gate times)
+    // (drain before reading the clock so no record is newer than the frame)
+    audioProcessor.drainTriggerTelemetry(triggerHistory);
+
+    // Ages are measured on the audio sample clock. When it stops moving (transport
+    // stopped processing, device closed) it is carried on by the message thread's
+    // clock, so glows still fade out instead of freezing.
+    const auto audioSamplePosition = audioProcessor.getSamplePosition();
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+
+    if (audioSamplePosition != lastAudioSamplePosition)
+    {
+        lastAudioSamplePosition = audioSamplePosition;
+        audioClockAdvancedMs = nowMs;
+        frameSamplePosition = audioSamplePosition;
+    }
+    else
+    {
+        const double msSinceAdvance = nowMs - audioClockAdvancedMs;
+        frameSamplePosition = audioSamplePosition
+                            + static_cast<juce::int64>(msSinceAdvance * audioProcessor.getSampleRate() / 1000.0);
+    }
+
+    if (speedChanged.exchange(false))
+        updateSpeedDisplay();
+
+    triggerHistory.erase(
+        std::remove_if(triggerHistory.begin(), triggerHistory.end(),
+            [this](const SkaldProcessor::TriggeredDotInfo& entry) {
+                return getTriggerAgeMs(entry) > 1000.0f;
+            }),
+        triggerHistory.end()
+    );
+    indexRecentTriggers();
+
     // Repaint to update the rotating turntable
     repaint();
 }
 
+void SkaldEditor::parameterChanged(const juce::String&, float)
+{
+    // Called on whichever thread changed the speed (often the audio thread), so only
+    // flag it - the next frame updates the display
+    speedChanged = true;
+}
+
 //==============================================================================
 // Helper methods
 
+void SkaldEditor::updateSpeedDisplay()
+{
+    const juce::String speedOptions[] = { "0.25x", "0.5x", "1x", "2x", "4x" };
+
+    // Show the nearest tap-button step (steps are powers of two around 1x)
+    float speed = audioProcessor.getSpeed();
+    int nearestIndex = juce::jlimit(0, 4, juce::roundToInt(std::log2(speed)) + 2);
+
+    if (nearestIndex != currentSpeedIndex)
+    {
+        currentSpeedIndex = nearestIndex;
+        speedDisplay.setText(speedOptions[currentSpeedIndex], juce::dontSendNotification);
+    }
+}
+
 float SkaldEditor::angleFromPoint(juce::Point<float> point)
 {
     auto delta = point - turntableCenter;
@@ -1812,43 +2039,27 @@ juce::Point<float> SkaldEditor::pointFromAngle(float angle, float radius)
     );
 }
 
-int SkaldEditor::findDotAtPoint(juce::Point<float> point)
+DotId SkaldEditor::findDotAtPoint(juce::Point<float> point)
 {
-    auto& dots = audioProcessor.getDots();
-    float innerRadius = turntableRadius * 0.90f;
+    // Turn the point back into pattern space instead of every dot into screen space
+    updatePlacedDots();
+    float rotation = audioProcessor.getCurrentRotation() * juce::MathConstants<float>::pi / 180.0f;
+    auto delta = point - turntableCenter;
+    auto patternPoint = juce::Point<float>(
+        delta.x * std::cos(rotation) - delta.y * std::sin(rotation),
+        delta.x * std::sin(rotation) + delta.y * std::cos(rotation)
+    );
 
-    for (size_t i = 0; i < dots.size(); ++i)
+    for (const auto& placed : placedDots)
     {
-        if (!dots[i].active)
-            continue;
-
-        // Calculate position on the appropriate ring
-        int ringIndex = dots[i].ringIndex;
-        float spacing = getRingSpacing();
-        float ringOuterRadius = innerRadius * (0.95f - ringIndex * spacing);
-        float ringInnerRadius = innerRadius * (0.95f - (ringIndex + 1) * spacing);
-        float ringMidRadius = (ringOuterRadius + ringInnerRadius) / 2.0f;
-
-        // Convert dot angle to visual position
-        // Angles are stored in our system where 0° = top
-        // cos/sin expect standard math where 0° = right
-        // So we subtract 90° to convert: standard = our - 90°
-        float angleInOurSystem = dots[i].angle - audioProcessor.getCurrentRotation();
-        float angleInStandardMath = angleInOurSystem - 90.0f;
-        float visualAngle = angleInStandardMath * juce::MathConstants<float>::pi / 180.0f;
-        auto dotPos = juce::Point<float>(
-            turntableCenter.x + std::cos(visualAngle) * ringMidRadius,
-            turntableCenter.y + std::sin(visualAngle) * ringMidRadius
-        );
-
         // Check if point is within dot bounds (with larger tolerance for easier clicking)
-        if (point.getDistanceFrom(dotPos) <= 12.0f)
+        if (patternPoint.getDistanceFrom(placed.position) <= 12.0f)
         {
-            return static_cast<int>(i);
+            return placed.id;
         }
     }
 
-    return -1;
+    return invalidDotId;
 }
 
 float SkaldEditor::getRingSpacing() const
@@ -1867,6 +2078,52 @@ juce::String SkaldEditor::midiNoteToString(int midiNote) const
     return juce::String(noteNames[noteInOctave]) + juce::String(octave);
 }
 
+void SkaldEditor::indexRecentTriggers()
+{
+    for (auto slot : recentTriggerSlots)
+        recentTriggerBySlot[slot] = -1;
+
+    recentTriggerSlots.clear();
+
+    // Later entries are newer, so each dot ends up with its latest trigger
+    const auto& dots = audioProcessor.getDots();
+    for (size_t i = 0; i < triggerHistory.size(); ++i)
+    {
+        const auto& info = triggerHistory[i];
+        if (getTriggerAgeMs(info) > 200.0f || !dots.contains(info.dotId))
+            continue;
+
+        const auto slot = SlotMap<TurntableDot>::getSlot(info.dotId);
+        if (slot >= recentTriggerBySlot.size())
+            recentTriggerBySlot.resize(slot + 1, -1);
+
+        if (recentTriggerBySlot[slot] < 0)
+            recentTriggerSlots.push_back(slot);
+
+        recentTriggerBySlot[slot] = static_cast<int>(i);
+    }
+}
+
+const SkaldProcessor::TriggeredDotInfo* SkaldEditor::findRecentTrigger(DotId id) const
+{
+    const auto slot = SlotMap<TurntableDot>::getSlot(id);
+    if (slot >= recentTriggerBySlot.size() || recentTriggerBySlot[slot] < 0)
+        return nullptr;
+
+    const auto& info = triggerHistory[static_cast<size_t>(recentTriggerBySlot[slot])];
+    return info.dotId == id ? &info : nullptr;
+}
+
+float SkaldEditor::getTriggerAgeMs(const SkaldProcessor::TriggeredDotInfo& info) const
+{
+    // Telemetry is stamped with the audio sample clock rather than wall-clock time
+    double sampleRate = audioProcessor.getSampleRate();
+    if (sampleRate <= 0.0)
+        return 0.0f;
+
+    return static_cast<float>((frameSamplePosition - info.samplePosition) * 1000.0 / sampleRate);
+}
+
 float SkaldEditor::calculateGlowBrightness(int velocity) const
 {
     // Map velocity (1-127) to brightness multiplier (0.3 - 1.0)
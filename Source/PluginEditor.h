@@ -4,6 +4,9 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "PluginProcessor.h"
 
+#include <atomic>
+#include <bitset>
+
 //==============================================================================
 // Forward declaration
 class SkaldEditor;
@@ -65,9 +68,38 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MusicToggle)
 };
 
+//==============================================================================
+// Soft radial glows pre-rendered as alpha masks at a few sizes, so a glow is one
+// image blit tinted by the current colour instead of a stack of ellipses
+class GlowAtlas
+{
+public:
+    enum GlowType
+    {
+        armGlow,        // Cyan flare where a triggered dot passes under the arm
+        dotGlow,        // Light around a dot
+        tracerGlow,     // Gate-time trail left behind a triggered dot
+        numGlowTypes
+    };
+
+    // Renders the masks for this many physical pixels per logical pixel; does nothing
+    // if they are already at that scale
+    void prepare(float scale);
+
+    // Draws the glow centred on centre, radius logical pixels out to its faint edge, in
+    // colour - the colour's alpha fades the whole glow
+    void draw(juce::Graphics& g, GlowType type, juce::Point<float> centre, float radius, juce::Colour colour) const;
+
+private:
+    static constexpr int numSizes = 4;          // Diameters 16, 32, 64 and 128 logical pixels
+    std::array<std::array<juce::Image, numSizes>, numGlowTypes> masks;
+    float preparedScale = 0.0f;
+};
+
 //==============================================================================
 class SkaldEditor : public juce::AudioProcessorEditor,
-                            private juce::Timer
+                            private juce::Timer,
+                            private juce::AudioProcessorValueTreeState::Listener
 {
 public:
     SkaldEditor (SkaldProcessor&);
@@ -80,6 +112,7 @@ public:
     void mouseUp (const juce::MouseEvent& event) override;
     void mouseDrag (const juce::MouseEvent& event) override;
     void timerCallback() override;
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
 
     // Images (public so LookAndFeel can access)
     juce::Image vikingFullImage;   // Full body for help/about screen
@@ -140,6 +173,18 @@ private:
     juce::Label velocityVariationLabel;
     MusicKnob swingKnob;
     juce::Label swingLabel;
+
+    // Bind the knobs and toggles to the processor's parameters (declared after the
+    // controls so they are destroyed first)
+    using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
+    using ButtonAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
+    std::unique_ptr<SliderAttachment> velocityAttachment;
+    std::unique_ptr<SliderAttachment> gateTimeAttachment;
+    std::unique_ptr<SliderAttachment> probabilityAttachment;
+    std::unique_ptr<SliderAttachment> velocityVariationAttachment;
+    std::unique_ptr<SliderAttachment> swingAttachment;
+    std::unique_ptr<ButtonAttachment> reverseAttachment;
+    std::unique_ptr<ButtonAttachment> startStopAttachment;
     juce::TextButton savePatternButton;
     juce::Label saveLabel;
     juce::TextButton loadPatternButton;
@@ -154,6 +199,8 @@ private:
 
     // Current selection indices
     int currentSpeedIndex = 2; // Default to 1x
+    void updateSpeedDisplay();
+    std::atomic<bool> speedChanged { true };   // Set by the parameter listener, on any thread
     int currentScaleIndex = 4; // Default to Pentatonic
     int currentKeyIndex = 0;   // Default to C
     int currentOctaveIndex = 2; // Default to baseline (0 = -2, 1 = -1, 2 = 0, 3 = +1, 4 = +2)
@@ -163,8 +210,53 @@ private:
     float turntableRadius = 150.0f;
     juce::Point<float> turntableCenter;
 
+    // Pre-rendered static artwork at device resolution (see paint)
+    juce::Image staticLayer;               // Wallpaper and platter, under the LED ring
+    juce::Image trackLayer;                // Ring tracks and arm, over the LED ring
+    juce::Rectangle<int> trackBounds;      // Where trackLayer goes, in editor coordinates
+    juce::Image spindleLayer;
+    juce::Rectangle<int> spindleBounds;    // Where spindleLayer goes, in editor coordinates
+    float staticLayerScale = 0.0f;         // Physical pixels per logical pixel it was drawn at
+    int staticLayerNumRings = -1;
+    void renderStaticLayers(float scale);
+    void paintWallpaper(juce::Graphics& g);
+    void paintTurntableBase(juce::Graphics& g);
+    void paintRingTracksAndArm(juce::Graphics& g);
+    void paintSpindle(juce::Graphics& g);
+
+    // Active dots at rotation 0, relative to the turntable centre - rebuilt only when
+    // the pattern, the ring count or the size changes
+    struct PlacedDot
+    {
+        DotId id;
+        juce::Point<float> position;
+    };
+    std::vector<PlacedDot> placedDots;
+    juce::uint32 placedDotsVersion = 0;
+    int placedDotsNumRings = -1;
+    float placedDotsRadius = 0.0f;
+    void updatePlacedDots();
+    float getRingMidRadius(int ringIndex) const;
+
+    // Which LEDs of the indicator ring sit near a dot, rebuilt when the pattern changes
+    static constexpr int numLEDs = 60;
+    std::bitset<numLEDs> ledOccupancy;
+    juce::uint32 ledOccupancyVersion = 0;
+    bool ledOccupancyValid = false;
+    void updateLedOccupancy();
+
+    GlowAtlas glowAtlas;
+
+    // placedDots drawn once, at device resolution, in their resting state (see paint)
+    juce::Image dotLayer;
+    float dotLayerScale = 0.0f;
+    float dotLayerHalfSize = 0.0f;         // Distance from the turntable centre to the layer's edges
+    void updateDotLayer(float scale);
+    void paintDotLight(juce::Graphics& g, const TurntableDot& dot, juce::Point<float> dotPos,
+                       bool isSelected, const SkaldProcessor::TriggeredDotInfo* triggerInfo);
+
     // Interaction state
-    int selectedDotIndex = -1;
+    DotId selectedDotId = invalidDotId;
     bool isDraggingDot = false;
     int currentMidiChannel = 1;
 
@@ -198,13 +290,27 @@ private:
     // Helper methods
     float angleFromPoint(juce::Point<float> point);
     juce::Point<float> pointFromAngle(float angle, float radius);
-    int findDotAtPoint(juce::Point<float> point);
+    DotId findDotAtPoint(juce::Point<float> point);
     float getRingSpacing() const;
     juce::String midiNoteToString(int midiNote) const;
     void paintHelpScreen(juce::Graphics& g);
     void setControlsVisible(bool visible);
 
+    // Trigger telemetry drained from the processor once per frame
+    std::vector<SkaldProcessor::TriggeredDotInfo> triggerHistory;
+    juce::int64 frameSamplePosition = 0;  // Audio sample clock at the last drain (see timerCallback)
+    juce::int64 lastAudioSamplePosition = -1;
+    double audioClockAdvancedMs = 0.0;    // Message-thread time the audio clock last moved
+
+    // Each dot's latest trigger from the last 200ms, indexed once per frame by the
+    // slot of the dot's id: position in triggerHistory, or -1
+    std::vector<int> recentTriggerBySlot;
+    std::vector<std::uint32_t> recentTriggerSlots;  // The slots that have one
+    void indexRecentTriggers();
+    const SkaldProcessor::TriggeredDotInfo* findRecentTrigger(DotId id) const;
+
     // Visual feedback helpers
+    float getTriggerAgeMs(const SkaldProcessor::TriggeredDotInfo& info) const;
     float calculateGlowBrightness(int velocity) const;
     float getSwingOffset(int beatCount, float swingAmount) const;
 
@@ -1,24 +1,108 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "Core/RealtimeCheck.h"
 
 //==============================================================================
 SkaldProcessor::SkaldProcessor()
      : AudioProcessor (BusesProperties()
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
-                      )
-{
-    // Initialize scale
-    updateScaleNotes();
+                      ),
+       parameters (*this, nullptr, "Parameters", createParameterLayout())
+{
+    speedParam = parameters.getRawParameterValue(ParamIDs::speed);
+    velocityParam = parameters.getRawParameterValue(ParamIDs::velocity);
+    gateTimeParam = parameters.getRawParameterValue(ParamIDs::gateTime);
+    reverseParam = parameters.getRawParameterValue(ParamIDs::reverse);
+    motorParam = parameters.getRawParameterValue(ParamIDs::motor);
+    probabilityParam = parameters.getRawParameterValue(ParamIDs::probability);
+    velocityVariationParam = parameters.getRawParameterValue(ParamIDs::velocityVariation);
+    swingParam = parameters.getRawParameterValue(ParamIDs::swing);
+    hostSyncParam = parameters.getRawParameterValue(ParamIDs::hostSync);
+
+    // Probability and velocity variation differ from run to run, as before
+    engine.setRandomSeed(juce::Random().nextInt64());
 
     // Start with a simple pentatonic melody pattern
     addDot(0.0f, 0, juce::Colour(0xffff6b35));      // Root
     addDot(90.0f, 2, juce::Colour(0xffff6b35));     // 3rd note
     addDot(180.0f, 4, juce::Colour(0xffff6b35));    // 5th note
     addDot(270.0f, 2, juce::Colour(0xffff6b35));    // 3rd note
+
+    // Periodically free pattern snapshots the audio thread has finished with
+    startTimerHz(10);
 }
 
 SkaldProcessor::~SkaldProcessor()
 {
+    stopTimer();
+}
+
+juce::AudioProcessorValueTreeState::ParameterLayout SkaldProcessor::createParameterLayout()
+{
+    juce::AudioProcessorValueTreeState::ParameterLayout layout;
+
+    juce::NormalisableRange<float> speedRange(0.25f, 4.0f);
+    speedRange.setSkewForCentre(1.0f);
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::speed, 1 }, "Speed", speedRange, 1.0f));
+
+    layout.add(std::make_unique<juce::AudioParameterInt>(
+        juce::ParameterID { ParamIDs::velocity, 1 }, "Velocity", 1, 127, 100));
+
+    juce::NormalisableRange<float> gateRange(10.0f, 2000.0f);
+    gateRange.setSkewForCentre(250.0f);
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::gateTime, 1 }, "Gate Time", gateRange, 100.0f));
+
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID { ParamIDs::reverse, 1 }, "Reverse", false));
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID { ParamIDs::motor, 1 }, "Motor", true));
+
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::probability, 1 }, "Probability",
+        juce::NormalisableRange<float>(0.0f, 100.0f), 100.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::velocityVariation, 1 }, "Velocity Variation",
+        juce::NormalisableRange<float>(0.0f, 100.0f), 0.0f));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID { ParamIDs::swing, 1 }, "Swing",
+        juce::NormalisableRange<float>(0.0f, 100.0f), 0.0f));
+
+    // Host-only: the editor has no switch for it, hosts list it with the other parameters
+    layout.add(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID { ParamIDs::hostSync, 1 }, "Host Sync", true));
+
+    return layout;
+}
+
+EngineParameters SkaldProcessor::getEngineParameters() const
+{
+    // Lock-free atomic reads
+    EngineParameters params;
+    params.speed = speedParam->load();
+    params.velocity = juce::roundToInt(velocityParam->load());
+    params.gateTimeMs = gateTimeParam->load();
+    params.reverse = reverseParam->load() >= 0.5f;
+    params.motorRunning = motorParam->load() >= 0.5f;
+    params.probability = probabilityParam->load();
+    params.velocityVariation = velocityVariationParam->load();
+    params.swing = swingParam->load();
+    params.hostSync = hostSyncParam->load() >= 0.5f;
+    return params;
+}
+
+void SkaldProcessor::setParameterValue(const char* paramID, float newValue)
+{
+    // Goes through the host so the change is recorded as automation. A one-shot change
+    // is a whole gesture, as a control attachment would report it, so hosts in touch or
+    // latch mode record it and can undo it.
+    if (auto* param = parameters.getParameter(paramID))
+    {
+        param->beginChangeGesture();
+        param->setValueNotifyingHost(param->convertTo0to1(newValue));
+        param->endChangeGesture();
+    }
 }
 
 //==============================================================================
@@ -77,7 +161,13 @@ void SkaldProcessor::changeProgramName (int index, const juce::String& newName)
 void SkaldProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
     this->sampleRate = sampleRate;
-    triggeredThisRotation.resize(dots.size(), false);
+
+    engine.prepare(sampleRate, samplesPerBlock, getEngineParameters());
+
+    // A note event takes 9 bytes in a MidiBuffer; leave room to spare
+    blockMidiOutput.ensureSize(static_cast<size_t>(maxNoteOnsPerBlock + maxNoteOffsPerBlock) * 16);
+
+    previousBlockStartMs = juce::Time::getMillisecondCounterHiRes();
 }
 
 void SkaldProcessor::releaseResources()
@@ -92,47 +182,48 @@ bool SkaldProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
 void SkaldProcessor::processBlock (juce::AudioBuffer<float>& buffer,
                                            juce::MidiBuffer& midiMessages)
 {
-    buffer.clear();
-
-    // Process active note-offs first (notes that should end in this buffer)
-    std::vector<ActiveNote> notesToKeep;
-    for (const auto& note : activeNotes)
-    {
-        juce::int64 noteOffInBuffer = note.noteOffSample - totalSamplesProcessed;
+    // The block's start time, to place previews where they were requested (below) - the
+    // message thread can only stamp them with this clock, not with a sample position.
+    // It is the audio thread's one clock read, taken before the real-time scope opens;
+    // the counter is a user-space read of the monotonic clock, so it never locks,
+    // allocates or makes a blocking call.
+    const double blockStartMs = juce::Time::getMillisecondCounterHiRes();
 
-        if (noteOffInBuffer < buffer.getNumSamples() && noteOffInBuffer >= 0)
-        {
-            // Note-off occurs in this buffer
-            juce::MidiMessage noteOff = juce::MidiMessage::noteOff(note.channel, note.midiNote, (juce::uint8) 0);
-            midiMessages.addEvent(noteOff, static_cast<int>(noteOffInBuffer));
-        }
-        else if (noteOffInBuffer >= buffer.getNumSamples())
-        {
-            // Note continues into future buffers
-            notesToKeep.push_back(note);
-        }
-        // If noteOffInBuffer < 0, note already ended - discard it
-    }
-    activeNotes = notesToKeep;
+    SKALD_REALTIME_SCOPE;
 
-    // Send any queued preview notes
+    buffer.clear();
+    const int numSamples = buffer.getNumSamples();
+
+    // Some hosts send empty blocks; there is nowhere to put a note in one, so any
+    // previews stay queued for the next block
+    if (numSamples == 0)
+        return;
+
+    // Snapshot the parameters once per block, so automation takes effect at block
+    // boundaries: swing, and speed when free-running, then glide to the new value
+    // across the block (see SkaldEngine); the rest step there
+    const EngineParameters params = getEngineParameters();
+
+    // Collect any queued preview notes (lock-free). A preview requested during the previous
+    // block is placed at the same offset into this one, so drags keep their timing
+    // instead of bunching up at sample 0.
+    int numPreviews = 0;
+    previewFifo.read(previewFifo.getNumReady()).forEach([&](int index)
     {
-        juce::ScopedLock lock(previewNotesLock);
-        for (const auto& previewNote : previewNotesToSend)
-        {
-            juce::MidiMessage noteOn = juce::MidiMessage::noteOn(1, previewNote.midiNote, (juce::uint8) 100);
-            midiMessages.addEvent(noteOn, 0);
+        const auto& request = previewBuffer[static_cast<size_t>(index)];
 
-            // Schedule note-off for preview (100ms)
-            juce::int64 noteOffSample = totalSamplesProcessed + static_cast<juce::int64>(sampleRate * 0.1);
-            activeNotes.push_back({previewNote.midiNote, 1, noteOffSample});
-        }
-        previewNotesToSend.clear();
-    }
+        double msIntoPreviousBlock = request.timeStampMs - previousBlockStartMs;
+        int previewSample = juce::jlimit(0, numSamples - 1,
+                                         static_cast<int>(msIntoPreviousBlock * sampleRate / 1000.0));
+
+        blockPreviews[static_cast<size_t>(numPreviews++)] = { request.midiNote, previewSample };
+    });
+    previousBlockStartMs = blockStartMs;
 
     // Determine if we're playing and what BPM to use
-    bool shouldPlay = isPlayingStandalone;  // Default to standalone state
-    double currentBPM = standaloneBPM;
+    TransportState transport;
+    transport.isPlaying = isPlayingStandalone;  // Default to standalone state
+    transport.bpm = standaloneBPM;
 
     // Get BPM and play state from host (overrides standalone if available)
     if (auto* playHead = getPlayHead())
@@ -141,302 +232,76 @@ void SkaldProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         {
             if (positionInfo->getBpm().hasValue())
             {
-                currentBPM = *positionInfo->getBpm();
+                transport.bpm = *positionInfo->getBpm();
             }
 
             // If host is providing play state, use it
             if (positionInfo->getIsPlaying())
             {
-                shouldPlay = true;
+                transport.isPlaying = true;
+                transport.isHostPlaying = true;
             }
-        }
-    }
-
-    // Record player-style motor control: ramp up/down speed
-    // Motor only runs when BOTH DAW transport is playing AND motor toggle is ON
-    const float rampUpRate = 3.0f;    // Fast start (reaches full speed in ~0.33 seconds)
-    const float rampDownRate = 0.4f;  // Gradual stop (comes to halt in ~2.5 seconds)
-    const float rampStep = 1.0f / sampleRate;  // Per-sample increment
-
-    if (motorRunning && shouldPlay)  // BOTH conditions must be true
-    {
-        // Ramp up to full speed
-        if (currentSpeedMultiplier < 1.0f)
-            currentSpeedMultiplier = juce::jmin(1.0f, currentSpeedMultiplier + (rampUpRate * rampStep * buffer.getNumSamples()));
-    }
-    else
-    {
-        // Ramp down to stop (if either motor is OFF or DAW is stopped)
-        if (currentSpeedMultiplier > 0.0f)
-            currentSpeedMultiplier = juce::jmax(0.0f, currentSpeedMultiplier - (rampDownRate * rampStep * buffer.getNumSamples()));
-    }
-
-    // Scratching physics: apply friction to scratch velocity (like motor slowdown)
-    if (!isBeingScratched && std::abs(scratchVelocity) > 0.01f)
-    {
-        // Apply friction to slow down the "thrown" turntable
-        // Use same decay rate as motor ramp-down for consistent feel
-        const float scratchDecayRate = 0.4f;  // Same as motor ramp down
-        const float decayStep = scratchDecayRate / sampleRate;
-        float velocityReduction = decayStep * buffer.getNumSamples();
-
-        // Reduce velocity toward zero
-        if (scratchVelocity > 0.0f)
-            scratchVelocity = juce::jmax(0.0f, scratchVelocity - (std::abs(scratchVelocity) * velocityReduction));
-        else
-            scratchVelocity = juce::jmin(0.0f, scratchVelocity + (std::abs(scratchVelocity) * velocityReduction));
-
-        // Stop completely if velocity is very small
-        if (std::abs(scratchVelocity) < 0.1f)
-            scratchVelocity = 0.0f;
-    }
-
-    // Apply scratch momentum (when not being actively scratched but has velocity)
-    float previousRotation = currentRotation;
-    if (!isBeingScratched && std::abs(scratchVelocity) > 0.01f)
-    {
-        // Apply scratch velocity
-        float scratchIncrement = scratchVelocity * (buffer.getNumSamples() / sampleRate);
-        currentRotation += scratchIncrement;
 
-        // Wrap around and reset triggers when completing a rotation
-        if (currentRotation < 0.0f)
-        {
-            currentRotation += 360.0f;
-            // Reset trigger tracking when we complete a rotation (backward)
-            std::fill(triggeredThisRotation.begin(), triggeredThisRotation.end(), false);
-        }
-        else if (currentRotation >= 360.0f)
-        {
-            currentRotation = std::fmod(currentRotation, 360.0f);
-            // Reset trigger tracking when we complete a rotation (forward)
-            std::fill(triggeredThisRotation.begin(), triggeredThisRotation.end(), false);
-        }
-    }
-    // Only advance rotation if playing (or if motor is spinning down) and NOT being scratched or thrown
-    // Only use motor rotation when scratch velocity is zero to avoid interference
-    else if (!isBeingScratched && std::abs(scratchVelocity) < 0.01f && (shouldPlay || currentSpeedMultiplier > 0.0f))
-    {
-        // Calculate rotation increment based on BPM and speed
-        // One full rotation per 2 bars (8 beats) at normal speed
-        // Apply reverse if enabled
-        double beatsPerSecond = currentBPM / 60.0;
-        double effectiveSpeed = isReversed ? -speed : speed;
-        effectiveSpeed *= currentSpeedMultiplier;  // Apply motor ramp
-        double rotationsPerSecond = (beatsPerSecond / 8.0) * effectiveSpeed;
-        double degreesPerSample = (rotationsPerSecond * 360.0) / sampleRate;
-        float rotationIncrement = static_cast<float>(degreesPerSample * buffer.getNumSamples());
-
-        currentRotation += rotationIncrement;
-
-        // Wrap around and reset triggers when completing a rotation (both directions)
-        if (currentRotation < 0.0f)
-        {
-            currentRotation += 360.0f;
-            // Reset trigger tracking when we complete a rotation (backward/reverse)
-            std::fill(triggeredThisRotation.begin(), triggeredThisRotation.end(), false);
-        }
-        else if (currentRotation >= 360.0f)
-        {
-            currentRotation = std::fmod(currentRotation, 360.0f);
-            // Reset trigger tracking when we complete a rotation (forward)
-            std::fill(triggeredThisRotation.begin(), triggeredThisRotation.end(), false);
-        }
-    }
-
-    // Note triggering: Check each dot to see if we've crossed its angle
-    // This works for normal playback, scratching, and scratch momentum
-    if (previousRotation != currentRotation)
-    {
-        // Check each dot to see if we've crossed its angle
-        for (size_t i = 0; i < dots.size(); ++i)
-        {
-            if (!dots[i].active)
-                continue;
-
-            // Calculate the trigger angle (when dot is at top/under sensor)
-            // Visual angle 0° = top (sensor arm position)
-            // Trigger when: (dot.angle - currentRotation) = 0°
-            // Which means: currentRotation = dot.angle
-            float triggerAngle = dots[i].angle;
-
-            // Check if we've crossed the trigger angle (works for both directions)
-            // Add small tolerance to handle floating-point precision and very small movements
-            bool crossed = false;
-            float rotationDelta = currentRotation - previousRotation;
-            const float tolerance = 0.5f;  // 0.5 degree tolerance for edge cases
-
-            // Handle wrap-around
-            if (rotationDelta > 180.0f)
-                rotationDelta -= 360.0f;
-            else if (rotationDelta < -180.0f)
-                rotationDelta += 360.0f;
-
-            if (std::abs(rotationDelta) < 0.001f)
-            {
-                // No movement - skip crossing check
-                continue;
-            }
-            else if (rotationDelta > 0.0f)
-            {
-                // Forward rotation (clockwise)
-                float diff = triggerAngle - previousRotation;
-                if (diff < 0.0f) diff += 360.0f;
-                // Add tolerance: allow trigger if within range + tolerance
-                crossed = (diff >= -tolerance && diff <= rotationDelta + tolerance);
-            }
-            else if (rotationDelta < 0.0f)
+            // Host musical position (quarter notes) and loop range, used to lock the
+            // rotation phase to the host's bar grid
+            if (auto ppq = positionInfo->getPpqPosition())
             {
-                // Reverse rotation (counter-clockwise)
-                float diff = previousRotation - triggerAngle;
-                if (diff < 0.0f) diff += 360.0f;
-                // Add tolerance: allow trigger if within range + tolerance
-                crossed = (diff >= -tolerance && diff <= -rotationDelta + tolerance);
+                transport.hasPpqPosition = true;
+                transport.ppqPosition = *ppq;
             }
 
-            // Trigger MIDI note if we crossed this dot and haven't triggered it yet
-            if (crossed && !triggeredThisRotation[i])
+            if (positionInfo->getIsLooping())
             {
-                // Apply probability - check if this note should trigger
-                float probRoll = random.nextFloat() * 100.0f;
-                bool passedProbability = probRoll <= probability;
-
-                if (!passedProbability)
-                {
-                    // Track the dot pass but mark as not triggered for visual feedback
-                    {
-                        juce::ScopedLock lock(triggeredDotsLock);
-                        auto currentTime = juce::Time::currentTimeMillis();
-                        recentlyTriggeredDots.push_back({
-                            static_cast<int>(i),
-                            currentTime,
-                            0,              // velocity (not used when not triggered)
-                            0.0f,           // gateTimeMs (not used when not triggered)
-                            false,          // wasTriggered = false
-                            swingBeatCounter
-                        });
-
-                        // Clean up old entries (older than 1000ms to accommodate gate times)
-                        recentlyTriggeredDots.erase(
-                            std::remove_if(recentlyTriggeredDots.begin(), recentlyTriggeredDots.end(),
-                                [currentTime](const TriggeredDotInfo& entry) {
-                                    return (currentTime - entry.timestamp) > 1000;
-                                }),
-                            recentlyTriggeredDots.end()
-                        );
-                    }
-
-                    triggeredThisRotation[i] = true; // Mark as triggered even if skipped
-                    continue; // Skip this note
-                }
-
-                // Calculate exactly when in the block the crossing occurred
-                int triggerSample = 0;
-
-                if (previousRotation < currentRotation)
-                {
-                    // Normal case: calculate how far through the block the crossing happened
-                    float rotationRange = currentRotation - previousRotation;
-                    float rotationToCrossing = triggerAngle - previousRotation;
-
-                    if (rotationRange > 0.0f)
-                    {
-                        float fraction = rotationToCrossing / rotationRange;
-                        triggerSample = static_cast<int>(fraction * buffer.getNumSamples());
-                        triggerSample = juce::jlimit(0, buffer.getNumSamples() - 1, triggerSample);
-                    }
-                }
-                // For wrap-around case, trigger at start of block for simplicity
-
-                // Apply swing timing based on beat position in rotation
-                // One full rotation = 8 beats, so calculate which beat this note falls on
-                swingBeatCounter++;
-                if (swing > 0.0f)
+                if (auto loop = positionInfo->getLoopPoints())
                 {
-                    // Calculate which 16th note subdivision this trigger falls on (0-31)
-                    // One rotation = 8 beats = 32 sixteenth notes
-                    float rotationProgress = currentRotation / 360.0f;  // 0.0 to 1.0
-                    int sixteenthNote = static_cast<int>(rotationProgress * 32.0f) % 32;
-
-                    // Apply swing to every other 16th note (odd numbered ones)
-                    // This creates the classic "long-short" swing pattern
-                    if (sixteenthNote % 2 == 1)
-                    {
-                        // Calculate tempo-relative swing delay
-                        // At 100% swing: delay by full 16th note (dramatic swing)
-                        // At 66% swing: classic jazz triplet feel
-                        // At 50% swing: no swing (straight)
-                        double secondsPerBeat = 60.0 / currentBPM;
-                        double sixteenthNoteDuration = secondsPerBeat / 4.0;  // 16th note subdivision
-
-                        // Swing percentage maps to delay amount:
-                        // 50% = no delay (straight), 66% = triplet feel, 100% = full 16th delay
-                        float swingRatio = (swing / 100.0f);  // 0.0 to 1.0
-                        float delayRatio = (swingRatio - 0.5f) * 2.0f;  // -1.0 to 1.0, centered at 0.5 (50%)
-                        delayRatio = juce::jlimit(0.0f, 1.0f, delayRatio);  // Clamp to 0.0-1.0
-
-                        double swingDelaySec = sixteenthNoteDuration * delayRatio;
-                        int swingOffset = static_cast<int>(swingDelaySec * sampleRate);
-                        triggerSample = juce::jmin(buffer.getNumSamples() - 1, triggerSample + swingOffset);
-                    }
+                    transport.isLooping = true;
+                    transport.loopStartPpq = loop->ppqStart;
+                    transport.loopEndPpq = loop->ppqEnd;
                 }
+            }
+        }
+    }
 
-                // Get MIDI note from ring index based on current scale
-                int midiNote = ringToMidiNote(dots[i].ringIndex);
+    // clear() keeps the storage, so the next block reuses it
+    blockMidiOutput.clear();
+    blockNoteOns = 0;
+    blockNoteOffs = 0;
+    engine.process(numSamples, transport, params, *this, blockPreviews.data(), numPreviews);
 
-                // Calculate velocity with variation
-                int finalVelocity = globalVelocity;
-                if (velocityVariation > 0.0f)
-                {
-                    // Add random variation based on velocityVariation parameter
-                    float variation = (random.nextFloat() * 2.0f - 1.0f) * (velocityVariation / 100.0f);
-                    finalVelocity = static_cast<int>(globalVelocity * (1.0f + variation * 0.5f));
-                    finalVelocity = juce::jlimit(1, 127, finalVelocity);
-                }
+    // The host's buffer belongs to the plugin wrapper, which sizes it up front and reuses
+    // it; the caps above bound what is added to it, so it can only grow (once) if a host
+    // gives a buffer smaller than a full block of notes
+    midiMessages.addEvents(blockMidiOutput, 0, numSamples, 0);
+}
 
-                // All notes go to MIDI channel 1
-                juce::MidiMessage noteOn = juce::MidiMessage::noteOn(
-                    1,  // Channel 1
-                    midiNote,
-                    (juce::uint8) finalVelocity  // Use calculated velocity
-                );
-                midiMessages.addEvent(noteOn, triggerSample);
+//==============================================================================
+// EngineEventSink
+void SkaldProcessor::noteOn(int sampleInBlock, int channel, int midiNote, int velocity)
+{
+    // Past the cap the note is dropped (note-offs only reach their cap after this)
+    if (blockNoteOns == maxNoteOnsPerBlock)
+        return;
 
-                // Schedule note-off based on gate time (will be sent in future buffer)
-                juce::int64 absoluteNoteOffSample = totalSamplesProcessed + triggerSample +
-                    static_cast<juce::int64>(sampleRate * (gateTimeMs / 1000.0));
-                activeNotes.push_back({midiNote, 1, absoluteNoteOffSample});
+    ++blockNoteOns;
+    blockMidiOutput.addEvent(juce::MidiMessage::noteOn(channel, midiNote, (juce::uint8) velocity), sampleInBlock);
+}
 
-                triggeredThisRotation[i] = true;
+void SkaldProcessor::noteOff(int sampleInBlock, int channel, int midiNote)
+{
+    if (blockNoteOffs == maxNoteOffsPerBlock)
+        return;
 
-                // Track this dot for visual feedback with full parameter info
-                {
-                    juce::ScopedLock lock(triggeredDotsLock);
-                    auto currentTime = juce::Time::currentTimeMillis();
-                    recentlyTriggeredDots.push_back({
-                        static_cast<int>(i),
-                        currentTime,
-                        finalVelocity,      // Actual velocity after variation
-                        gateTimeMs,         // Gate time parameter
-                        true,               // wasTriggered = true
-                        swingBeatCounter    // Beat counter for swing visualization
-                    });
-
-                    // Clean up old entries (older than 1000ms to accommodate gate times)
-                    recentlyTriggeredDots.erase(
-                        std::remove_if(recentlyTriggeredDots.begin(), recentlyTriggeredDots.end(),
-                            [currentTime](const TriggeredDotInfo& entry) {
-                                return (currentTime - entry.timestamp) > 1000;
-                            }),
-                        recentlyTriggeredDots.end()
-                    );
-                }
-            }
-        }
-    }
+    ++blockNoteOffs;
+    blockMidiOutput.addEvent(juce::MidiMessage::noteOff(channel, midiNote, (juce::uint8) 0), sampleInBlock);
+}
 
-    // Increment total samples processed for accurate note-off timing across buffers
-    totalSamplesProcessed += buffer.getNumSamples();
+void SkaldProcessor::dotPassed(const TriggerEvent& event)
+{
+    // Wait-free; if the FIFO is full the record is simply dropped
+    telemetryFifo.write(1).forEach([this, &event](int index)
+    {
+        telemetryBuffer[static_cast<size_t>(index)] = event;
+    });
 }
 
 //==============================================================================
@@ -453,12 +318,13 @@ juce::AudioProcessorEditor* SkaldProcessor::createEditor()
 //==============================================================================
 void SkaldProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // Save plugin state (dots configuration, speed, scale, etc.)
+    // Save plugin state (dots configuration, speed, scale, etc.). This is also the
+    // .ttp pattern file format - PatternFile reads it outside the plugin.
     juce::MemoryOutputStream stream(destData, false);
 
-    stream.writeFloat(speed);
-    stream.writeInt(static_cast<int>(currentScale));
-    stream.writeInt(rootNote);
+    stream.writeFloat(getSpeed());
+    stream.writeInt(static_cast<int>(getScale()));
+    stream.writeInt(getRootNote());
     stream.writeInt(static_cast<int>(dots.size()));
 
     for (const auto& dot : dots)
@@ -470,12 +336,13 @@ void SkaldProcessor::getStateInformation (juce::MemoryBlock& destData)
     }
 
     // Save new parameters
-    stream.writeInt(globalVelocity);
-    stream.writeFloat(gateTimeMs);
-    stream.writeBool(isReversed);
-    stream.writeFloat(probability);
-    stream.writeFloat(velocityVariation);
-    stream.writeFloat(swing);
+    stream.writeInt(getGlobalVelocity());
+    stream.writeFloat(getGateTime());
+    stream.writeBool(getReverse());
+    stream.writeFloat(getProbability());
+    stream.writeFloat(getVelocityVariation());
+    stream.writeFloat(getSwing());
+    stream.writeBool(getHostSync());
 }
 
 void SkaldProcessor::setStateInformation (const void* data, int sizeInBytes)
@@ -483,10 +350,20 @@ void SkaldProcessor::setStateInformation (const void* data, int sizeInBytes)
     // Restore plugin state
     juce::MemoryInputStream stream(data, static_cast<size_t>(sizeInBytes), false);
 
-    speed = stream.readFloat();
-    currentScale = static_cast<ScaleType>(stream.readInt());
-    rootNote = stream.readInt();
-    updateScaleNotes();
+    // Parameters are written into a copy of the parameter state and applied together with
+    // replaceState, the way JUCE restores a session, rather than through the setters -
+    // those report each value to the host as if the user had just moved the control
+    auto parameterState = parameters.copyState();
+    auto restoreParameter = [&parameterState](const char* paramID, float value)
+    {
+        auto parameter = parameterState.getChildWithProperty("id", juce::String(paramID));
+        if (parameter.isValid())
+            parameter.setProperty("value", value, nullptr);
+    };
+
+    restoreParameter(ParamIDs::speed, stream.readFloat());
+    setScale(static_cast<ScaleType>(stream.readInt()));
+    setRootNote(stream.readInt());
 
     int numDots = stream.readInt();
 
@@ -498,114 +375,83 @@ void SkaldProcessor::setStateInformation (const void* data, int sizeInBytes)
         dot.ringIndex = stream.readInt();
         dot.color = juce::Colour(stream.readInt());
         dot.active = stream.readBool();
-        dots.push_back(dot);
+        insertDot(dot);
     }
 
-    triggeredThisRotation.resize(dots.size(), false);
+    publishPattern();
 
-    // Load new parameters (with defaults for older saved states)
+    // Load new parameters (older saved states keep the current values)
     if (!stream.isExhausted())
     {
-        globalVelocity = stream.readInt();
-        gateTimeMs = stream.readFloat();
-        isReversed = stream.readBool();
-        probability = stream.readFloat();
-        velocityVariation = stream.readFloat();
-        swing = stream.readFloat();
+        restoreParameter(ParamIDs::velocity, static_cast<float>(stream.readInt()));
+        restoreParameter(ParamIDs::gateTime, stream.readFloat());
+        restoreParameter(ParamIDs::reverse, stream.readBool() ? 1.0f : 0.0f);
+        restoreParameter(ParamIDs::probability, stream.readFloat());
+        restoreParameter(ParamIDs::velocityVariation, stream.readFloat());
+        restoreParameter(ParamIDs::swing, stream.readFloat());
     }
+
+    if (!stream.isExhausted())
+        restoreParameter(ParamIDs::hostSync, stream.readBool() ? 1.0f : 0.0f);
+
+    parameters.replaceState(parameterState);
 }
 
 //==============================================================================
-void SkaldProcessor::addDot(float angle, int ringIndex, juce::Colour color)
+DotId SkaldProcessor::addDot(float angle, int ringIndex, juce::Colour color)
 {
     TurntableDot dot;
     dot.angle = angle;
     dot.ringIndex = ringIndex;
     dot.color = color;
     dot.active = true;
-    dots.push_back(dot);
-    triggeredThisRotation.resize(dots.size(), false);
+    const auto id = insertDot(dot);
+    publishPattern();
+    return id;
 }
 
-void SkaldProcessor::removeDot(int index)
+DotId SkaldProcessor::insertDot(TurntableDot dot)
 {
-    if (index >= 0 && index < static_cast<int>(dots.size()))
-    {
-        dots.erase(dots.begin() + index);
-        triggeredThisRotation.resize(dots.size(), false);
-    }
-}
+    const auto id = dots.insert(dot);
+    if (auto* inserted = dots.find(id))
+        inserted->id = id;
 
-void SkaldProcessor::clearAllDots()
-{
-    dots.clear();
-    triggeredThisRotation.clear();
+    return id;
 }
 
-//==============================================================================
-// Scale system implementation
-
-std::vector<int> SkaldProcessor::getScaleIntervals(ScaleType scale)
+void SkaldProcessor::removeDot(DotId id)
 {
-    switch (scale)
-    {
-        case ScaleType::Major:           return {0, 2, 4, 5, 7, 9, 11, 12};
-        case ScaleType::Minor:           return {0, 2, 3, 5, 7, 8, 10, 12};
-        case ScaleType::HarmonicMinor:   return {0, 2, 3, 5, 7, 8, 11, 12};
-        case ScaleType::MelodicMinor:    return {0, 2, 3, 5, 7, 9, 11, 12};
-        case ScaleType::Pentatonic:      return {0, 2, 4, 7, 9, 12};
-        case ScaleType::PentatonicMinor: return {0, 3, 5, 7, 10, 12};
-        case ScaleType::Blues:           return {0, 3, 5, 6, 7, 10, 12};
-        case ScaleType::Dorian:          return {0, 2, 3, 5, 7, 9, 10, 12};
-        case ScaleType::Phrygian:        return {0, 1, 3, 5, 7, 8, 10, 12};
-        case ScaleType::Lydian:          return {0, 2, 4, 6, 7, 9, 11, 12};
-        case ScaleType::Mixolydian:      return {0, 2, 4, 5, 7, 9, 10, 12};
-        case ScaleType::Locrian:         return {0, 1, 3, 5, 6, 8, 10, 12};
-        case ScaleType::Chromatic:       return {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
-        default:                         return {0, 2, 4, 7, 9, 12};
-    }
+    if (dots.remove(id))
+        publishPattern();
 }
 
-void SkaldProcessor::updateScaleNotes()
+void SkaldProcessor::moveDot(DotId id, float angle, int ringIndex)
 {
-    scaleNotes.clear();
-    auto intervals = getScaleIntervals(currentScale);
-
-    // Create single octave of the scale
-    int baseMIDI = rootNote + (baseOctave * 12);
-    for (int interval : intervals)
+    if (auto* dot = dots.find(id))
     {
-        // Skip the octave repeat (12) to keep it to one octave
-        if (interval == 12) continue;
-        scaleNotes.push_back(baseMIDI + interval);
+        dot->angle = angle;
+        dot->ringIndex = ringIndex;
+        publishPattern();
     }
 }
 
-void SkaldProcessor::setScale(ScaleType newScale)
+void SkaldProcessor::clearAllDots()
 {
-    currentScale = newScale;
-    updateScaleNotes();
+    dots.clear();
+    publishPattern();
 }
 
-void SkaldProcessor::setRootNote(int newRoot)
+void SkaldProcessor::publishPattern()
 {
-    rootNote = juce::jlimit(0, 11, newRoot);
-    updateScaleNotes();
-}
+    ++patternVersion;
 
-void SkaldProcessor::setOctaveShift(int shift)
-{
-    octaveShift = juce::jlimit(-2, 2, shift);
+    // The audio thread only ever sees complete, immutable copies of the pattern
+    engine.publishPattern(std::vector<PatternDot>(dots.begin(), dots.end()));
 }
 
-int SkaldProcessor::ringToMidiNote(int ringIndex) const
+void SkaldProcessor::timerCallback()
 {
-    if (ringIndex >= 0 && ringIndex < static_cast<int>(scaleNotes.size()))
-    {
-        int baseNote = scaleNotes[ringIndex];
-        return baseNote + (octaveShift * 12); // Apply octave shift
-    }
-    return 60; // Default to middle C
+    engine.collectGarbage();
 }
 
 //==============================================================================
@@ -614,21 +460,26 @@ void SkaldProcessor::triggerPreviewNote(int ringIndex)
 {
     int midiNote = ringToMidiNote(ringIndex);
 
-    juce::ScopedLock lock(previewNotesLock);
-    PreviewNote preview;
+    PreviewRequest preview;
     preview.midiNote = midiNote;
-    preview.timeStamp = 0;
-    previewNotesToSend.push_back(preview);
+    preview.timeStampMs = juce::Time::getMillisecondCounterHiRes();
+
+    // Drop policy: if the audio thread hasn't caught up (queue full), the newest
+    // preview is discarded rather than ever blocking either thread
+    previewFifo.write(1).forEach([this, &preview](int index)
+    {
+        previewBuffer[static_cast<size_t>(index)] = preview;
+    });
 }
 
 //==============================================================================
-// Get recently triggered dots for visual feedback
-std::vector<SkaldProcessor::TriggeredDotInfo> SkaldProcessor::getRecentlyTriggeredDots() const
+// Trigger telemetry for visual feedback
+void SkaldProcessor::drainTriggerTelemetry(std::vector<TriggeredDotInfo>& destination)
 {
-    juce::ScopedLock lock(triggeredDotsLock);
-
-    // Return all recently triggered dots (cleanup happens in processBlock)
-    return recentlyTriggeredDots;
+    telemetryFifo.read(telemetryFifo.getNumReady()).forEach([this, &destination](int index)
+    {
+        destination.push_back(telemetryBuffer[static_cast<size_t>(index)]);
+    });
 }
 
 //==============================================================================
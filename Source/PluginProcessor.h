@@ -2,52 +2,39 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_graphics/juce_graphics.h>
+#include "Core/SkaldEngine.h"
 
 //==============================================================================
-// Scale types
-enum class ScaleType
+// Data structure for a single dot on a turntable
+struct TurntableDot : PatternDot
 {
-    Major,
-    Minor,
-    HarmonicMinor,
-    MelodicMinor,
-    Pentatonic,
-    PentatonicMinor,
-    Blues,
-    Dorian,
-    Phrygian,
-    Lydian,
-    Mixolydian,
-    Locrian,
-    Chromatic
+    juce::Colour color { juce::Colours::red }; // Visual color representation
 };
 
-// Data structure for a single dot on a turntable
-struct TurntableDot
+// Host-automatable parameter IDs
+namespace ParamIDs
 {
-    float angle;        // Position on the turntable (0-360 degrees)
-    int ringIndex;      // Which ring (0-11) - determines pitch in scale
-    juce::Colour color; // Visual color representation
-    bool active;        // Whether this dot is active
-
-    TurntableDot() : angle(0.0f), ringIndex(0),
-                     color(juce::Colours::red), active(true) {}
-};
+    inline constexpr const char* speed             = "speed";
+    inline constexpr const char* velocity          = "velocity";
+    inline constexpr const char* gateTime          = "gateTime";
+    inline constexpr const char* reverse           = "reverse";
+    inline constexpr const char* motor             = "motor";
+    inline constexpr const char* probability       = "probability";
+    inline constexpr const char* velocityVariation = "velocityVariation";
+    inline constexpr const char* swing             = "swing";
+    inline constexpr const char* hostSync          = "hostSync";
+}
 
 //==============================================================================
-class SkaldProcessor : public juce::AudioProcessor
+// Adapts SkaldEngine to the plugin host: parameters, transport, MIDI output
+// and the editor's preview/telemetry queues
+class SkaldProcessor : public juce::AudioProcessor,
+                       private EngineEventSink,
+                       private juce::Timer
 {
 public:
     // Track recently triggered dots for visual feedback
-    struct TriggeredDotInfo
-    {
-        int dotIndex;
-        juce::int64 timestamp;
-        int velocity;           // Actual triggered velocity (after variation)
-        float gateTimeMs;       // Gate time for this trigger
-        bool wasTriggered;      // True if probability allowed trigger
-        int beatCount;          // Beat counter state (for swing visualization)
-    };
+    using TriggeredDotInfo = TriggerEvent;
 
     SkaldProcessor();
     ~SkaldProcessor() override;
@@ -81,69 +68,85 @@ public:
     void setStateInformation (const void* data, int sizeInBytes) override;
 
     //==============================================================================
-    // Turntable-specific methods
-    void addDot(float angle, int ringIndex, juce::Colour color);
-    void removeDot(int index);
+    // Turntable-specific methods (message thread only - each edit publishes a new
+    // pattern snapshot for the audio thread). Dots are addressed by their id, which
+    // stays valid until the dot is removed; stale ids are ignored.
+    DotId addDot(float angle, int ringIndex, juce::Colour color);
+    void removeDot(DotId id);
+    void moveDot(DotId id, float angle, int ringIndex);
     void clearAllDots();
-    std::vector<TurntableDot>& getDots() { return dots; }
+    const SlotMap<TurntableDot>& getDots() const { return dots; }
+    // Changes whenever the dots do, so views can tell when to rebuild anything derived from them
+    juce::uint32 getPatternVersion() const { return patternVersion; }
 
     // Scale and key management
-    void setScale(ScaleType newScale);
-    void setRootNote(int newRoot); // 0-11 (C-B)
-    void setOctaveShift(int shift); // -2, -1, 0, +1, +2
-    ScaleType getScale() const { return currentScale; }
-    int getRootNote() const { return rootNote; }
-    int getOctaveShift() const { return octaveShift; }
-    int getNumRings() const { return scaleNotes.size(); }
+    void setScale(ScaleType newScale) { engine.getScaleSystem().setScale(newScale); }
+    void setRootNote(int newRoot) { engine.getScaleSystem().setRootNote(newRoot); } // 0-11 (C-B)
+    void setOctaveShift(int shift) { engine.getScaleSystem().setOctaveShift(shift); } // -2, -1, 0, +1, +2
+    ScaleType getScale() const { return engine.getScaleSystem().getScale(); }
+    int getRootNote() const { return engine.getScaleSystem().getRootNote(); }
+    int getOctaveShift() const { return engine.getScaleSystem().getOctaveShift(); }
+    int getNumRings() const { return engine.getScaleSystem().getNumRings(); }
 
     // Convert ring index to MIDI note based on current scale/key
-    int ringToMidiNote(int ringIndex) const;
+    int ringToMidiNote(int ringIndex) const { return engine.getScaleSystem().ringToMidiNote(ringIndex); }
 
     // Get scale intervals
-    static std::vector<int> getScaleIntervals(ScaleType scale);
+    static constexpr const ScaleIntervals& getScaleIntervals(ScaleType scale) { return ScaleSystem::getScaleIntervals(scale); }
+
+    //==============================================================================
+    // Performance parameters live in the value tree state so the host can automate
+    // them; the audio thread reads them through atomics once per block. Setters notify
+    // the host.
+    juce::AudioProcessorValueTreeState parameters;
 
     // Speed control (1.0 = normal speed, 2.0 = double speed, etc.)
-    void setSpeed(float newSpeed) { speed = newSpeed; }
-    float getSpeed() const { return speed; }
+    void setSpeed(float newSpeed) { setParameterValue(ParamIDs::speed, newSpeed); }
+    float getSpeed() const { return speedParam->load(); }
 
     // Get current rotation angle (for GUI visualization)
-    float getCurrentRotation() const { return currentRotation; }
+    float getCurrentRotation() const { return engine.getCurrentRotation(); }
 
     // Velocity control (1-127)
-    void setGlobalVelocity(int vel) { globalVelocity = juce::jlimit(1, 127, vel); }
-    int getGlobalVelocity() const { return globalVelocity; }
+    void setGlobalVelocity(int vel) { setParameterValue(ParamIDs::velocity, static_cast<float>(vel)); }
+    int getGlobalVelocity() const { return juce::roundToInt(velocityParam->load()); }
 
     // Gate time control (in milliseconds)
-    void setGateTime(float timeMs) { gateTimeMs = juce::jmax(10.0f, timeMs); }
-    float getGateTime() const { return gateTimeMs; }
+    void setGateTime(float timeMs) { setParameterValue(ParamIDs::gateTime, timeMs); }
+    float getGateTime() const { return gateTimeParam->load(); }
 
     // Reverse rotation
-    void setReverse(bool shouldReverse) { isReversed = shouldReverse; }
-    bool getReverse() const { return isReversed; }
+    void setReverse(bool shouldReverse) { setParameterValue(ParamIDs::reverse, shouldReverse ? 1.0f : 0.0f); }
+    bool getReverse() const { return reverseParam->load() >= 0.5f; }
 
     // Motor control (record player style start/stop)
-    void setMotorRunning(bool shouldRun) { motorRunning = shouldRun; }
-    bool getMotorRunning() const { return motorRunning; }
+    void setMotorRunning(bool shouldRun) { setParameterValue(ParamIDs::motor, shouldRun ? 1.0f : 0.0f); }
+    bool getMotorRunning() const { return motorParam->load() >= 0.5f; }
 
     // Scratching control (manual turntable manipulation)
-    void setScratchVelocity(float velocity) { scratchVelocity = velocity; }
-    float getScratchVelocity() const { return scratchVelocity; }
-    void setBeingScratched(bool scratching) { isBeingScratched = scratching; }
-    void setRotationDirect(float angle) { currentRotation = angle; }
-    float getCurrentSpeedMultiplier() const { return currentSpeedMultiplier; }
-    void setCurrentSpeedMultiplier(float mult) { currentSpeedMultiplier = mult; }
+    void setScratchVelocity(float velocity) { engine.setScratchVelocity(velocity); }
+    float getScratchVelocity() const { return engine.getScratchVelocity(); }
+    void setBeingScratched(bool scratching) { engine.setBeingScratched(scratching); }
+    void setRotationDirect(float angle) { engine.setRotationDirect(angle); }
+    float getCurrentSpeedMultiplier() const { return engine.getCurrentSpeedMultiplier(); }
+    void setCurrentSpeedMultiplier(float mult) { engine.setCurrentSpeedMultiplier(mult); }
 
     // Probability control (0-100%)
-    void setProbability(float prob) { probability = juce::jlimit(0.0f, 100.0f, prob); }
-    float getProbability() const { return probability; }
+    void setProbability(float prob) { setParameterValue(ParamIDs::probability, prob); }
+    float getProbability() const { return probabilityParam->load(); }
 
     // Velocity variation (0-100%)
-    void setVelocityVariation(float var) { velocityVariation = juce::jlimit(0.0f, 100.0f, var); }
-    float getVelocityVariation() const { return velocityVariation; }
+    void setVelocityVariation(float var) { setParameterValue(ParamIDs::velocityVariation, var); }
+    float getVelocityVariation() const { return velocityVariationParam->load(); }
 
     // Swing amount (0-100%)
-    void setSwing(float sw) { swing = juce::jlimit(0.0f, 100.0f, sw); }
-    float getSwing() const { return swing; }
+    void setSwing(float sw) { setParameterValue(ParamIDs::swing, sw); }
+    float getSwing() const { return swingParam->load(); }
+
+    // Lock the rotation phase to the host's musical position while its transport runs.
+    // Host-only - the editor has no control for it.
+    void setHostSync(bool shouldSync) { setParameterValue(ParamIDs::hostSync, shouldSync ? 1.0f : 0.0f); }
+    bool getHostSync() const { return hostSyncParam->load() >= 0.5f; }
 
     // Standalone transport control
     void setPlaying(bool shouldPlay) { isPlayingStandalone = shouldPlay; }
@@ -156,82 +159,90 @@ public:
     // Get effective BPM (standalone or host)
     double getBPM() const { return hostBPM; }
 
-    // Preview note triggering (for UI feedback)
+    // Preview note triggering (for UI feedback). Message thread only (single producer);
+    // wait-free, and the preview is dropped if the queue is full.
     void triggerPreviewNote(int ringIndex);
 
-    // Get recently triggered dots for visual feedback
-    std::vector<TriggeredDotInfo> getRecentlyTriggeredDots() const;
+    // Visual feedback: moves every trigger record published by the audio thread since
+    // the last call onto the end of destination. Message thread only (single consumer).
+    void drainTriggerTelemetry(std::vector<TriggeredDotInfo>& destination);
+
+    // Audio sample clock at the end of the last processed block (for ageing telemetry)
+    juce::int64 getSamplePosition() const { return engine.getSamplePosition(); }
 
 private:
-    // Structure to track active MIDI notes for proper note-off timing
-    struct ActiveNote
-    {
-        int midiNote;
-        int channel;
-        juce::int64 noteOffSample;  // Absolute sample position when note should turn off
-    };
-    std::vector<ActiveNote> activeNotes;
-    juce::int64 totalSamplesProcessed = 0;  // Track absolute sample position
+    // The sequencer; everything below adapts it to the host
+    SkaldEngine engine;
+
     //==============================================================================
-    std::vector<TurntableDot> dots;
-    float currentRotation = 0.0f;  // Current rotation angle (0-360)
-    float speed = 1.0f;             // Rotation speed multiplier
+    // Working copy of the pattern, edited on the message thread. Each dot's id field
+    // holds its own slot map id.
+    SlotMap<TurntableDot> dots;
+    juce::uint32 patternVersion = 0;
+    DotId insertDot(TurntableDot dot);
+
+    void publishPattern();
+    void timerCallback() override;
+
     double hostBPM = 120.0;         // BPM from host DAW
     double sampleRate = 44100.0;
 
-    // Quick-win parameters
-    int globalVelocity = 100;       // MIDI velocity (1-127)
-    float gateTimeMs = 100.0f;      // Note duration in milliseconds
-    bool isReversed = false;        // Reverse rotation direction
-
-    // Motor control (record player style)
-    bool motorRunning = true;           // Motor on/off state
-    float currentSpeedMultiplier = 1.0f; // Current speed (ramps up/down like record player)
+    // Parameter layout and lock-free handles into the value tree state
+    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+    void setParameterValue(const char* paramID, float newValue);
 
-    // Scratching/manual control
-    float scratchVelocity = 0.0f;       // Angular velocity from scratching (degrees per second)
-    bool isBeingScratched = false;      // True when user is actively scratching
+    std::atomic<float>* speedParam = nullptr;             // Rotation speed multiplier
+    std::atomic<float>* velocityParam = nullptr;          // MIDI velocity (1-127)
+    std::atomic<float>* gateTimeParam = nullptr;          // Note duration in milliseconds
+    std::atomic<float>* reverseParam = nullptr;           // Reverse rotation direction
+    std::atomic<float>* motorParam = nullptr;             // Motor on/off state
+    std::atomic<float>* probabilityParam = nullptr;       // Probability of note trigger (0-100%)
+    std::atomic<float>* velocityVariationParam = nullptr; // Velocity randomization amount (0-100%)
+    std::atomic<float>* swingParam = nullptr;             // Swing amount (0-100%)
+    std::atomic<float>* hostSyncParam = nullptr;          // Follow host ppqPosition when available
 
-    // High-value parameters
-    float probability = 100.0f;     // Probability of note trigger (0-100%)
-    float velocityVariation = 0.0f; // Velocity randomization amount (0-100%)
-    float swing = 0.0f;             // Swing amount (0-100%)
+    EngineParameters getEngineParameters() const;
 
     // Standalone mode variables
     bool isPlayingStandalone = false;
     double standaloneBPM = 120.0;
 
-    // Scale and key settings
-    ScaleType currentScale = ScaleType::Pentatonic;
-    int rootNote = 0; // C
-    int baseOctave = 4; // C4 as base
-    int octaveShift = 0; // -2, -1, 0, +1, or +2 octave shift
-    std::vector<int> scaleNotes; // MIDI notes for current scale
-
-    // Update scale notes based on current settings
-    void updateScaleNotes();
-
-    // Track which notes we've triggered to avoid re-triggering
-    std::vector<bool> triggeredThisRotation;
-
-    // Preview notes queue (for UI feedback)
-    struct PreviewNote
+    // Preview notes queue (for UI feedback): bounded single-producer/single-consumer
+    // lock-free FIFO from the message thread to the audio thread
+    struct PreviewRequest
     {
         int midiNote;
-        int timeStamp;
+        double timeStampMs;  // High-resolution millisecond counter when it was requested
     };
-    std::vector<PreviewNote> previewNotesToSend;
-    juce::CriticalSection previewNotesLock;
-
-    // Track recently triggered dots for visual feedback
-    std::vector<TriggeredDotInfo> recentlyTriggeredDots;
-    juce::CriticalSection triggeredDotsLock;
-
-    // Random number generator for probability and velocity variation
-    juce::Random random;
-
-    // Track swing state (which beat we're on for swing timing)
-    int swingBeatCounter = 0;
+    static constexpr int previewFifoSize = 64;
+    juce::AbstractFifo previewFifo { previewFifoSize };
+    std::array<PreviewRequest, previewFifoSize> previewBuffer;
+    std::array<PreviewNote, previewFifoSize> blockPreviews;  // This block's previews, placed in time
+
+    // Wall-clock time at the start of the previous block, used to place preview notes
+    // at their request time with a constant one-block latency
+    double previousBlockStartMs = 0.0;
+
+    // Trigger telemetry for visual feedback: single-producer/single-consumer lock-free
+    // FIFO from the audio thread to the editor. Records are dropped if the editor
+    // falls behind - it's only used for drawing.
+    static constexpr int telemetryFifoSize = 1024;
+    juce::AbstractFifo telemetryFifo { telemetryFifoSize };
+    std::array<TriggeredDotInfo, telemetryFifoSize> telemetryBuffer;
+
+    // EngineEventSink: the engine's output for the block being processed, collected in a
+    // buffer sized in prepareToPlay, then merged into the host's buffer. The sink never
+    // fills it past that size: note-ons beyond maxNoteOnsPerBlock are dropped, and so are
+    // note-offs beyond maxNoteOffsPerBlock, which leaves room for every note-off the engine
+    // can have scheduled plus one for each note-on it may end in the same block.
+    static constexpr int maxNoteOnsPerBlock = 2048;
+    static constexpr int maxNoteOffsPerBlock = static_cast<int>(SkaldEngine::maxScheduledNoteOffs) + maxNoteOnsPerBlock;
+    juce::MidiBuffer blockMidiOutput;
+    int blockNoteOns = 0;
+    int blockNoteOffs = 0;
+    void noteOn(int sampleInBlock, int channel, int midiNote, int velocity) override;
+    void noteOff(int sampleInBlock, int channel, int midiNote) override;
+    void dotPassed(const TriggerEvent& event) override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SkaldProcessor)
 };
@@ -0,0 +1,115 @@
+// Regression test: host-synced playback across speed changes and transport jumps.
+//
+// A speed change mid-playback must keep the platter's angle and the notes swing has
+// already delayed; a transport jump must put the platter back on the bar grid.
+// Exits with status 1 if any check fails.
+//
+// Usage: HostSyncTest
+
+#include "SkaldEngine.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    struct Recorder : EngineEventSink
+    {
+        std::int64_t blockStart = 0;
+        std::vector<std::int64_t> noteOns;
+
+        void noteOn(int sampleInBlock, int, int, int) override { noteOns.push_back(blockStart + sampleInBlock); }
+        void noteOff(int, int, int) override {}
+        void dotPassed(const TriggerEvent&) override {}
+    };
+
+    constexpr double sampleRate = 48000.0;
+    constexpr double bpm = 120.0;
+    constexpr int blockSize = 512;
+    constexpr double ppqPerSample = bpm / (60.0 * sampleRate);
+
+    // Runs the engine with the host transport at ppq, one block
+    void processBlock(SkaldEngine& engine, Recorder& recorder, std::int64_t position, double ppq,
+                      const EngineParameters& params)
+    {
+        TransportState transport;
+        transport.bpm = bpm;
+        transport.isPlaying = true;
+        transport.isHostPlaying = true;
+        transport.hasPpqPosition = true;
+        transport.ppqPosition = ppq;
+
+        recorder.blockStart = position;
+        engine.process(blockSize, transport, params, recorder);
+    }
+
+    // Difference between two angles, wrapped into [-180, 180)
+    double angleDifference(double a, double b)
+    {
+        const double difference = std::fmod(a - b + 540.0, 360.0);
+        return (difference < 0.0 ? difference + 360.0 : difference) - 180.0;
+    }
+
+    bool expect(bool condition, const char* what)
+    {
+        std::printf("%-52s %s\n", what, condition ? "ok" : "FAILED");
+        return condition;
+    }
+}
+
+int main()
+{
+    EngineParameters params;
+    params.swing = 100.0f;   // Delays odd 16ths by a full 16th (6000 samples here)
+
+    SkaldEngine engine;
+    engine.prepare(sampleRate, blockSize, params);
+
+    // One rotation per 8 beats: 15 degrees is a third of a beat in, on the second 16th,
+    // so it crosses at sample 8000 and swing holds its note until sample 14000
+    engine.publishPattern({ { 15.0f, 0, true } });
+
+    Recorder recorder;
+    std::int64_t position = 0;
+    double ppq = 0.0;
+    bool passed = true;
+
+    for (int block = 0; block < 20; ++block, position += blockSize)
+    {
+        processBlock(engine, recorder, position, ppq, params);
+        ppq += blockSize * ppqPerSample;
+    }
+
+    // Double the speed while the swung note is still waiting
+    const double angleBeforeChange = engine.getCurrentRotation();
+    params.speed = 2.0f;
+    processBlock(engine, recorder, position, ppq, params);
+    position += blockSize;
+    ppq += blockSize * ppqPerSample;
+
+    const double expectedAngle = angleBeforeChange + 90.0 * blockSize * ppqPerSample;
+    passed = expect(std::abs(angleDifference(engine.getCurrentRotation(), expectedAngle)) < 1.0e-3,
+                    "speed change keeps the angle and turns at the new rate") && passed;
+
+    for (int block = 0; block < 20; ++block, position += blockSize)
+    {
+        processBlock(engine, recorder, position, ppq, params);
+        ppq += blockSize * ppqPerSample;
+    }
+
+    passed = expect(! recorder.noteOns.empty() && recorder.noteOns.front() == 14000,
+                    "swung note delayed across the speed change plays") && passed;
+
+    // Jump the transport: the angle is ppq * 90 degrees again
+    ppq = 37.25;
+    processBlock(engine, recorder, position, ppq, params);
+
+    const double gridAngle = (ppq + blockSize * ppqPerSample) * 90.0;
+    passed = expect(std::abs(angleDifference(engine.getCurrentRotation(), gridAngle)) < 1.0e-3,
+                    "transport jump puts the platter back on the bar grid") && passed;
+
+    std::printf(passed ? "PASS\n" : "FAIL\n");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,77 @@
+// Self-test for the SKALD_RT_CHECK instrumentation: every kind of call it is meant
+// to trap, made inside SKALD_REALTIME_SCOPE, must be reported - and the same calls
+// outside a scope must not be. Always built with the check on, whatever
+// SKALD_RT_CHECK is set to for the rest of the build.
+//
+// Usage: RealtimeCheckTest
+
+#include "RealtimeCheck.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+namespace
+{
+    // Keeps the compiler from eliding allocations whose result is never used
+    void* volatile escape = nullptr;
+
+    struct alignas(64) OverAligned
+    {
+        char bytes[64];
+    };
+
+    std::mutex mutex;
+
+    // Runs call inside a real-time scope and checks it was reported
+    template <typename Call>
+    bool expectViolation(const char* what, Call&& call)
+    {
+        const long long before = RealtimeCheck::getViolationCount();
+        {
+            SKALD_REALTIME_SCOPE;
+            call();
+        }
+
+        const bool reported = RealtimeCheck::getViolationCount() > before;
+        std::printf("%-28s %s\n", what, reported ? "trapped" : "MISSED");
+        return reported;
+    }
+}
+
+int main()
+{
+    RealtimeCheck::setAbortOnViolation(false);
+    bool passed = true;
+
+    passed = expectViolation("operator new", [] { escape = new int(1); }) && passed;
+    passed = expectViolation("operator delete", [] { delete static_cast<int*>(escape); }) && passed;
+    passed = expectViolation("aligned operator new", [] { escape = new OverAligned(); }) && passed;
+    passed = expectViolation("aligned operator delete", [] { delete static_cast<OverAligned*>(escape); }) && passed;
+
+   #if defined(__GLIBC__)
+    passed = expectViolation("malloc", [] { escape = std::malloc(16); }) && passed;
+    passed = expectViolation("realloc", [] { escape = std::realloc(escape, 64); }) && passed;
+    passed = expectViolation("free", [] { std::free(escape); }) && passed;
+    passed = expectViolation("calloc", [] { escape = std::calloc(4, 16); }) && passed;
+    std::free(escape);
+   #endif
+
+   #if defined(__linux__)
+    passed = expectViolation("mutex lock", [] { mutex.lock(); mutex.unlock(); }) && passed;
+   #endif
+
+    // Outside a scope nothing is reported
+    const long long before = RealtimeCheck::getViolationCount();
+    delete new int(2);
+    mutex.lock();
+    mutex.unlock();
+
+    const bool quiet = RealtimeCheck::getViolationCount() == before;
+    std::printf("%-28s %s\n", "calls outside a scope", quiet ? "ignored" : "REPORTED");
+    passed = passed && quiet;
+
+    std::printf(passed ? "PASS\n" : "FAIL\n");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,306 @@
+// Micro-benchmark for the sequencing engine's per-block cost.
+//
+// Drives SkaldEngine the way SkaldProcessor::processBlock does - a fake play head
+// advancing the transport, parameters sampled once per block - and sweeps dot
+// count, buffer size, speed and playback mode. For each case it reports mean and
+// worst-case nanoseconds per block, and how many heap allocations the audio path
+// made per block (should always be 0). Exits with status 1 if the audio path
+// allocated - or, in a SKALD_RT_CHECK build, made any real-time violation - so
+// it doubles as the real-time safety test.
+//
+// Usage: SkaldBench [--quick] [--seconds N]
+
+#include "SkaldEngine.h"
+#include "CrossingKernel.h"
+#include "RealtimeCheck.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+//==============================================================================
+// Allocation counting: every global operator new goes through here, and is
+// counted while the audio path is being measured. (SKALD_RT_CHECK builds replace
+// operator new themselves and count allocations inside real-time scopes.)
+namespace
+{
+    std::atomic<bool> countingAllocations { false };
+    std::atomic<long long> allocationCount { 0 };
+
+    long long getAllocationCount()
+    {
+       #if SKALD_RT_CHECK
+        return RealtimeCheck::getAllocationCount();
+       #else
+        return allocationCount.load();
+       #endif
+    }
+}
+
+#if ! SKALD_RT_CHECK
+namespace
+{
+    void* countedAllocate(std::size_t size)
+    {
+        if (countingAllocations.load(std::memory_order_relaxed))
+            allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+        if (void* p = std::malloc(size == 0 ? 1 : size))
+            return p;
+
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new(std::size_t size)                                   { return countedAllocate(size); }
+void* operator new[](std::size_t size)                                 { return countedAllocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept   { try { return countedAllocate(size); } catch (...) { return nullptr; } }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { try { return countedAllocate(size); } catch (...) { return nullptr; } }
+void operator delete(void* p) noexcept                                 { std::free(p); }
+void operator delete[](void* p) noexcept                               { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept                    { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept                  { std::free(p); }
+#endif
+
+//==============================================================================
+namespace
+{
+    // Stands in for the host: a transport running at a fixed tempo from bar 1
+    struct FakePlayHead
+    {
+        double sampleRate = 48000.0;
+        double bpm = 120.0;
+        long long samplePosition = 0;
+
+        TransportState getPosition() const
+        {
+            TransportState transport;
+            transport.bpm = bpm;
+            transport.isPlaying = true;
+            transport.isHostPlaying = true;
+            transport.hasPpqPosition = true;
+            transport.ppqPosition = static_cast<double>(samplePosition) * bpm / (60.0 * sampleRate);
+            return transport;
+        }
+
+        void advance(int numSamples) { samplePosition += numSamples; }
+    };
+
+    // Counts events instead of building MIDI, so only the engine is measured
+    struct CountingSink : EngineEventSink
+    {
+        long long noteOns = 0;
+        long long noteOffs = 0;
+        long long dotPasses = 0;
+
+        void noteOn(int, int, int, int) override  { ++noteOns; }
+        void noteOff(int, int, int) override      { ++noteOffs; }
+        void dotPassed(const TriggerEvent&) override { ++dotPasses; }
+    };
+
+    enum class Mode
+    {
+        Plain,        // Free-running, straight timing
+        SwingProb,    // Free-running with swing, probability and velocity variation
+        Reverse,      // Free-running backwards
+        Scratch,      // Platter thrown by hand (decaying scratch velocity)
+        HostSync,     // Phase-locked to the play head's ppqPosition (precompiled timeline)
+        SyncSweep     // Phase-locked, searching for crossings every block instead
+    };
+
+    const char* getModeName(Mode mode)
+    {
+        switch (mode)
+        {
+            case Mode::Plain:     return "plain";
+            case Mode::SwingProb: return "swing+prob";
+            case Mode::Reverse:   return "reverse";
+            case Mode::Scratch:   return "scratch";
+            case Mode::HostSync:  return "hostsync";
+            case Mode::SyncSweep: return "sync-sweep";
+        }
+        return "?";
+    }
+
+    struct BenchResult
+    {
+        double meanNsPerBlock = 0.0;
+        double worstNsPerBlock = 0.0;
+        double allocationsPerBlock = 0.0;
+        long long noteOns = 0;
+    };
+
+    std::vector<PatternDot> makePattern(int numDots)
+    {
+        // Evenly spread with a little jitter, across all rings
+        std::vector<PatternDot> dots;
+        dots.reserve(static_cast<size_t>(numDots));
+
+        const CounterRandom random(12345);
+        for (int i = 0; i < numDots; ++i)
+        {
+            PatternDot dot;
+            const float jitter = random.getFloat(0, static_cast<std::uint32_t>(i), 0);
+            dot.angle = 360.0f * (static_cast<float>(i) + 0.5f * jitter) / static_cast<float>(numDots);
+            dot.ringIndex = i % 8;
+            dots.push_back(dot);
+        }
+
+        return dots;
+    }
+
+    BenchResult runCase(int numDots, int blockSize, float speed, Mode mode, double seconds)
+    {
+        const double sampleRate = 48000.0;
+
+        EngineParameters params;
+        params.speed = speed;
+        params.reverse = mode == Mode::Reverse;
+        params.hostSync = mode == Mode::HostSync || mode == Mode::SyncSweep;
+
+        if (mode == Mode::SwingProb)
+        {
+            params.swing = 75.0f;
+            params.probability = 50.0f;
+            params.velocityVariation = 30.0f;
+        }
+
+        SkaldEngine engine;
+        engine.prepare(sampleRate, blockSize, params);
+        engine.setRandomSeed(1);
+        engine.setTimelineEnabled(mode != Mode::SyncSweep);
+        engine.publishPattern(makePattern(numDots));
+
+        FakePlayHead playHead;
+        playHead.sampleRate = sampleRate;
+        CountingSink sink;
+
+        const long long totalBlocks = std::max(1LL, static_cast<long long>(seconds * sampleRate) / blockSize);
+        const long long warmupBlocks = std::min(8LL, totalBlocks / 4);
+
+        double totalNs = 0.0;
+        double worstNs = 0.0;
+        long long measuredBlocks = 0;
+        long long allocationsBefore = 0;
+
+        for (long long block = 0; block < totalBlocks; ++block)
+        {
+            // Re-throw the platter once a second, as a hand would
+            if (mode == Mode::Scratch && playHead.samplePosition % static_cast<long long>(sampleRate) < blockSize)
+                engine.setScratchVelocity(720.0f * speed);
+
+            const TransportState transport = playHead.getPosition();
+            const bool measured = block >= warmupBlocks;
+
+            if (block == warmupBlocks)
+                allocationsBefore = getAllocationCount();
+
+            countingAllocations.store(measured, std::memory_order_relaxed);
+            const auto start = std::chrono::steady_clock::now();
+
+            {
+                // The real-time scope the plugin's processBlock() opens around the engine
+                SKALD_REALTIME_SCOPE;
+                engine.process(blockSize, transport, params, sink);
+            }
+
+            const auto end = std::chrono::steady_clock::now();
+            countingAllocations.store(false, std::memory_order_relaxed);
+
+            if (measured)
+            {
+                const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+                totalNs += ns;
+                worstNs = std::max(worstNs, ns);
+                ++measuredBlocks;
+            }
+
+            playHead.advance(blockSize);
+        }
+
+        engine.collectGarbage();
+
+        BenchResult result;
+        result.meanNsPerBlock = measuredBlocks > 0 ? totalNs / static_cast<double>(measuredBlocks) : 0.0;
+        result.worstNsPerBlock = worstNs;
+        result.allocationsPerBlock = measuredBlocks > 0 ? static_cast<double>(getAllocationCount() - allocationsBefore)
+                                                       / static_cast<double>(measuredBlocks) : 0.0;
+        result.noteOns = sink.noteOns;
+        return result;
+    }
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    bool quick = false;
+    double seconds = 4.0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--quick") == 0)
+            quick = true;
+        else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+            seconds = std::max(0.1, std::atof(argv[++i]));
+        else
+        {
+            std::fprintf(stderr, "Usage: %s [--quick] [--seconds N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    const std::vector<int> dotCounts = quick ? std::vector<int> { 4, 1000 }
+                                             : std::vector<int> { 4, 64, 1000, 10000 };
+    const std::vector<int> blockSizes = quick ? std::vector<int> { 64, 1024 }
+                                              : std::vector<int> { 16, 64, 256, 1024, 4096 };
+    const std::vector<float> speeds = quick ? std::vector<float> { 1.0f }
+                                            : std::vector<float> { 0.25f, 1.0f, 4.0f };
+    const Mode modes[] = { Mode::Plain, Mode::SwingProb, Mode::Reverse, Mode::Scratch, Mode::HostSync, Mode::SyncSweep };
+
+    if (quick)
+        seconds = std::min(seconds, 1.0);
+
+    std::printf("Crossing kernel: %s\n\n", CrossingKernel::getInstructionSet());
+    std::printf("%6s %6s %6s %-11s %12s %12s %10s %10s\n",
+                "dots", "block", "speed", "mode", "ns/block", "worst ns", "allocs/blk", "notes");
+
+    double totalAllocations = 0.0;
+
+    for (int numDots : dotCounts)
+        for (int blockSize : blockSizes)
+            for (float speed : speeds)
+                for (Mode mode : modes)
+                {
+                    const auto result = runCase(numDots, blockSize, speed, mode, seconds);
+                    totalAllocations += result.allocationsPerBlock;
+
+                    std::printf("%6d %6d %6.2f %-11s %12.0f %12.0f %10.3f %10lld\n",
+                                numDots, blockSize, speed, getModeName(mode),
+                                result.meanNsPerBlock, result.worstNsPerBlock,
+                                result.allocationsPerBlock, result.noteOns);
+                    std::fflush(stdout);
+                }
+
+    bool realtimeSafe = true;
+
+    if (totalAllocations > 0.0)
+    {
+        std::printf("\nFAIL: the audio path allocated memory\n");
+        realtimeSafe = false;
+    }
+
+   #if SKALD_RT_CHECK
+    if (RealtimeCheck::getViolationCount() > 0)
+    {
+        std::printf("\nFAIL: %lld real-time violations (see stderr)\n", RealtimeCheck::getViolationCount());
+        realtimeSafe = false;
+    }
+   #endif
+
+    return realtimeSafe ? 0 : 1;
+}
@@ -0,0 +1,361 @@
+// Offline renderer: plays saved patterns (.ttp) through the sequencing engine
+// faster than real time and writes what it played to Standard MIDI Files.
+//
+// Usage: SkaldRender [options] <pattern.ttp | directory>...
+//   -o, --output <file.mid>   Output file for a single render (default: <pattern>.mid)
+//   --out-dir <dir>           Where batch renders go (default: next to each pattern)
+//   --bpm <n[,n...]>          Tempo(s) (default 120)
+//   --bars <n>                Length in 4/4 bars (default 8)
+//   --sample-rate <n>         Engine sample rate (default 48000)
+//   --seed <n[,n...]>         Probability / velocity variation seed(s) (default 1)
+//   --jobs <n>                Worker threads for batches (default: one per core)
+//   --verify-serial           Re-render a batch on one thread and check it matches
+//
+// One pattern at one tempo and seed renders to a single file. Anything more - several
+// patterns, a directory of them, or lists of tempos/seeds - is a batch: every
+// pattern x tempo x seed combination is an independent job with its own engine,
+// spread across the cores, written as <pattern>-<bpm>bpm-seed<seed>.mid.
+//
+// Patterns that can't be read are reported and skipped, and the exit status is then 1.
+// Two patterns that would write the same output file (same name, different folders,
+// one --out-dir) stop the run before anything is rendered.
+
+#include "OfflineRenderer.h"
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    void printUsage(const char* program)
+    {
+        std::fprintf(stderr,
+                     "Usage: %s [options] <pattern.ttp | directory>...\n"
+                     "  -o, --output <file.mid>   Output file for a single render (default: <pattern>.mid)\n"
+                     "  --out-dir <dir>           Where batch renders go (default: next to each pattern)\n"
+                     "  --bpm <n[,n...]>          Tempo(s) (default 120)\n"
+                     "  --bars <n>                Length in 4/4 bars (default 8)\n"
+                     "  --sample-rate <n>         Engine sample rate (default 48000)\n"
+                     "  --seed <n[,n...]>         Random seed(s) (default 1)\n"
+                     "  --jobs <n>                Worker threads for batches (default: one per core)\n"
+                     "  --verify-serial           Check a batch renders identically on one thread\n",
+                     program);
+    }
+
+    bool parseNumber(const std::string& text, double& result)
+    {
+        char* end = nullptr;
+        result = std::strtod(text.c_str(), &end);
+        return !text.empty() && end == text.c_str() + text.size();
+    }
+
+    // "90,120,140" -> {90, 120, 140}
+    bool parseNumberList(const std::string& text, std::vector<double>& result)
+    {
+        result.clear();
+        size_t start = 0;
+
+        for (;;)
+        {
+            const auto comma = text.find(',', start);
+            double value = 0.0;
+            if (!parseNumber(text.substr(start, comma - start), value))
+                return false;
+
+            result.push_back(value);
+            if (comma == std::string::npos)
+                return true;
+
+            start = comma + 1;
+        }
+    }
+
+    // "1,2,3" -> {1, 2, 3}; whole numbers only, parsed exactly (no detour through double)
+    bool parseIntegerList(const std::string& text, std::vector<std::int64_t>& result)
+    {
+        result.clear();
+        size_t start = 0;
+
+        for (;;)
+        {
+            const auto comma = text.find(',', start);
+            const auto item = text.substr(start, comma - start);
+
+            char* end = nullptr;
+            errno = 0;
+            const long long value = std::strtoll(item.c_str(), &end, 10);
+            if (item.empty() || end != item.c_str() + item.size() || errno == ERANGE)
+                return false;
+
+            result.push_back(static_cast<std::int64_t>(value));
+            if (comma == std::string::npos)
+                return true;
+
+            start = comma + 1;
+        }
+    }
+
+    std::string formatNumber(double value)
+    {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%g", value);
+        return buffer;
+    }
+
+    // One pattern rendered at one tempo and seed
+    struct RenderJob
+    {
+        size_t patternIndex;
+        RenderSettings settings;
+        std::string outputPath;
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    RenderSettings baseSettings;
+    std::vector<double> bpms { baseSettings.bpm };
+    std::vector<std::int64_t> seeds { baseSettings.seed };
+    std::vector<std::string> inputs;
+    std::string outputPath;
+    std::string outputDirectory;
+    int numThreads = 0;
+    bool verifySerial = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        double value = 0.0;
+
+        if ((arg == "-o" || arg == "--output") && hasValue)
+            outputPath = argv[++i];
+        else if (arg == "--out-dir" && hasValue)
+            outputDirectory = argv[++i];
+        else if (arg == "--bpm" && hasValue && parseNumberList(argv[++i], bpms))
+            continue;
+        else if (arg == "--bars" && hasValue && parseNumber(argv[++i], value) && value >= 1.0)
+            baseSettings.bars = static_cast<int>(value);
+        else if (arg == "--sample-rate" && hasValue && parseNumber(argv[++i], value) && value >= 1000.0)
+            baseSettings.sampleRate = value;
+        else if (arg == "--seed" && hasValue && parseIntegerList(argv[++i], seeds))
+            continue;
+        else if (arg == "--jobs" && hasValue && parseNumber(argv[++i], value) && value >= 1.0)
+            numThreads = static_cast<int>(value);
+        else if (arg == "--verify-serial")
+            verifySerial = true;
+        else if (!arg.empty() && arg[0] != '-')
+            inputs.push_back(arg);
+        else
+        {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    for (double bpm : bpms)
+    {
+        if (bpm <= 0.0)
+        {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (inputs.empty())
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    // Expand directories into the patterns they contain, in a stable order
+    std::vector<std::string> patternPaths;
+    bool anyDirectory = false;
+    int exitCode = 0;
+
+    for (const auto& input : inputs)
+    {
+        std::error_code error;
+        if (fs::is_directory(input, error))
+        {
+            anyDirectory = true;
+
+            std::vector<std::string> found;
+            for (const auto& entry : fs::directory_iterator(input, error))
+                if (entry.is_regular_file(error) && entry.path().extension() == ".ttp")
+                    found.push_back(entry.path().string());
+
+            if (found.empty())
+            {
+                std::fprintf(stderr, "No .ttp pattern files found in %s\n", input.c_str());
+                exitCode = 1;
+            }
+
+            std::sort(found.begin(), found.end());
+            patternPaths.insert(patternPaths.end(), found.begin(), found.end());
+        }
+        else
+        {
+            patternPaths.push_back(input);
+        }
+    }
+
+    const bool isBatch = patternPaths.size() > 1 || bpms.size() > 1 || seeds.size() > 1
+                         || anyDirectory || !outputDirectory.empty();
+
+    // Unreadable patterns are reported and skipped; the rest still render
+    std::vector<std::string> loadedPaths;
+    std::vector<PatternFile> patterns;
+    for (const auto& path : patternPaths)
+    {
+        PatternFile pattern;
+        if (!PatternFile::load(path, pattern))
+        {
+            std::fprintf(stderr, "Couldn't read pattern file, skipping: %s\n", path.c_str());
+            exitCode = 1;
+            continue;
+        }
+
+        loadedPaths.push_back(path);
+        patterns.push_back(std::move(pattern));
+    }
+
+    if (patterns.empty())
+        return 1;
+
+    if (isBatch && !outputPath.empty())
+    {
+        std::fprintf(stderr, "-o names a single output; use --out-dir for batches\n");
+        return 2;
+    }
+
+    if (!outputDirectory.empty())
+    {
+        std::error_code error;
+        fs::create_directories(outputDirectory, error);
+    }
+
+    // Every pattern x tempo x seed combination is its own job
+    std::vector<RenderJob> jobs;
+    for (size_t p = 0; p < patterns.size(); ++p)
+    {
+        for (double bpm : bpms)
+        {
+            for (std::int64_t seed : seeds)
+            {
+                RenderJob job { p, baseSettings, {} };
+                job.settings.bpm = bpm;
+                job.settings.seed = seed;
+
+                const fs::path patternPath(loadedPaths[p]);
+                if (!isBatch)
+                {
+                    job.outputPath = outputPath.empty() ? fs::path(patternPath).replace_extension(".mid").string()
+                                                        : outputPath;
+                }
+                else
+                {
+                    const auto directory = outputDirectory.empty() ? patternPath.parent_path() : fs::path(outputDirectory);
+                    const auto name = patternPath.stem().string() + "-" + formatNumber(bpm) + "bpm-seed"
+                                      + std::to_string(job.settings.seed) + ".mid";
+                    job.outputPath = (directory / name).string();
+                }
+
+                jobs.push_back(job);
+            }
+        }
+    }
+
+    // Patterns with the same name from different directories would overwrite each other
+    // in --out-dir (as would the same pattern given twice)
+    std::vector<std::pair<std::string, size_t>> outputs;
+    for (size_t j = 0; j < jobs.size(); ++j)
+        outputs.emplace_back(fs::path(jobs[j].outputPath).lexically_normal().string(), jobs[j].patternIndex);
+
+    std::sort(outputs.begin(), outputs.end());
+    for (size_t n = 1; n < outputs.size(); ++n)
+    {
+        if (outputs[n].first == outputs[n - 1].first)
+        {
+            std::fprintf(stderr, "%s and %s would both be written to %s; rename one or render them separately\n",
+                         loadedPaths[outputs[n - 1].second].c_str(), loadedPaths[outputs[n].second].c_str(),
+                         outputs[n].first.c_str());
+            return 2;
+        }
+    }
+
+    // Each job builds its own engine (and so its own random stream), so the order
+    // jobs run in - and which thread runs them - can't change what they produce
+    WorkStealingPool pool(isBatch ? numThreads : 1);
+    std::vector<std::vector<std::uint8_t>> rendered(jobs.size());
+    std::vector<char> writeFailed(jobs.size(), 0);
+    std::vector<int> eventCounts(jobs.size(), 0);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    pool.run(jobs.size(), [&](size_t j)
+    {
+        const auto midiFile = renderPattern(patterns[jobs[j].patternIndex], jobs[j].settings);
+        eventCounts[j] = midiFile.getNumEvents();
+        writeFailed[j] = midiFile.writeTo(jobs[j].outputPath) ? 0 : 1;
+
+        if (verifySerial)
+            rendered[j] = midiFile.toBytes();
+    });
+
+    const double elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    long long totalEvents = 0;
+    for (size_t j = 0; j < jobs.size(); ++j)
+    {
+        totalEvents += eventCounts[j];
+
+        if (writeFailed[j])
+        {
+            std::fprintf(stderr, "Couldn't write MIDI file: %s\n", jobs[j].outputPath.c_str());
+            exitCode = 1;
+        }
+    }
+
+    if (!isBatch)
+    {
+        const auto& settings = jobs.front().settings;
+        const double renderedSeconds = settings.bars * 4.0 * 60.0 / settings.bpm;
+        std::printf("%s: %d bars at %.2f BPM, %d MIDI events, %.1f ms (%.0fx real time)\n",
+                    jobs.front().outputPath.c_str(), settings.bars, settings.bpm, eventCounts.front(),
+                    elapsedSeconds * 1000.0, elapsedSeconds > 0.0 ? renderedSeconds / elapsedSeconds : 0.0);
+        return exitCode;
+    }
+
+    std::printf("Rendered %zu patterns (%zu files x %zu tempos x %zu seeds), %lld MIDI events, "
+                "in %.3f s on %d threads: %.1f patterns/s\n",
+                jobs.size(), patterns.size(), bpms.size(), seeds.size(), totalEvents,
+                elapsedSeconds, pool.getNumThreads(),
+                elapsedSeconds > 0.0 ? static_cast<double>(jobs.size()) / elapsedSeconds : 0.0);
+
+    if (verifySerial)
+    {
+        size_t mismatches = 0;
+        for (size_t j = 0; j < jobs.size(); ++j)
+            if (renderPattern(patterns[jobs[j].patternIndex], jobs[j].settings).toBytes() != rendered[j])
+                ++mismatches;
+
+        std::printf("Serial check: %s (%zu of %zu differ)\n", mismatches == 0 ? "identical" : "MISMATCH",
+                    mismatches, jobs.size());
+
+        if (mismatches > 0)
+            exitCode = 1;
+    }
+
+    return exitCode;
+}